@@ -0,0 +1,142 @@
+#include "binsearch.h"
+
+// Algorithm:
+// Look at the miidle of the array:
+// If key lower, than key must be in lower half
+// If key bigger, than must be in upper half
+// This way search zone is halfed every iteration
+//
+// Complexity:
+// O(log(v.size())
+int_t rank(int_t arr, int_t len, int_t key) {
+  if (len == 0)
+    return -1;
+  int_t beg = 0;
+  int_t end = len - 1;
+
+  while (beg <= end) {
+    int_t mid = beg + (end - beg) / 2;
+    int_t mid_val = std_fmemget(arr + mid);
+    if (key < mid_val)
+      end = mid - 1;
+    else if (key > mid_val)
+      beg = mid + 1;
+    else
+      return mid;
+  }
+
+  return -1;
+}
+
+// Same search, but keep going until the search zone is empty:
+// [0, beg[ are all < key, and [beg, len[ are all >= key
+int_t lower_bound(int_t arr, int_t len, int_t key) {
+  int_t beg = 0;
+  int_t end = len;
+
+  while (beg < end) {
+    int_t mid = beg + (end - beg) / 2;
+    if (std_fmemget(arr + mid) < key)
+      beg = mid + 1;
+    else
+      end = mid;
+  }
+
+  return beg;
+}
+
+// The zone [beg, beg + len[ always contains the lower bound, or it's
+// beg + len
+// Every iteration removes half of the zone: beg moves forward if the middle
+// item is < key, computed with arithmetic instead of a branch
+int_t lower_bound_branchless(int_t arr, int_t len, int_t key) {
+  if (len == 0)
+    return 0;
+  int_t beg = 0;
+
+  while (len > 1) {
+    int_t half = len / 2;
+    beg = beg + half * (std_fmemget(arr + beg + half) < key);
+    len = len - half;
+  }
+
+  return beg + (std_fmemget(arr + beg) < key);
+}
+
+#define BATCH_SIZE (16)
+
+// Branchless lower bound, BATCH_SIZE keys at a time
+// All searches of a batch have the same zone length, so they advance in lock
+// step: one step for every key, then the next step, and the next middle items
+// are prefetched while the other keys are being compared
+void rank_many(int_t arr, int_t len, int_t keys, int_t n, int_t dst) {
+  int_t beg[BATCH_SIZE];
+  int_t key[BATCH_SIZE];
+  int_t first = 0;
+
+  while (first < n) {
+    int_t count = n - first < BATCH_SIZE ? n - first : BATCH_SIZE;
+    int_t j = 0;
+    while (j < count) {
+      beg[j] = 0;
+      key[j] = std_fmemget(keys + first + j);
+      j = j + 1;
+    }
+
+    int_t zone = len;
+    while (zone > 1) {
+      int_t half = zone / 2;
+      int_t next_half = (zone - half) / 2;
+      j = 0;
+      while (j < count) {
+        beg[j] = beg[j] + half * (std_fmemget(arr + beg[j] + half) < key[j]);
+        std_fmemprefetch(arr + beg[j] + next_half);
+        j = j + 1;
+      }
+      zone = zone - half;
+    }
+
+    j = 0;
+    while (j < count) {
+      int_t idx = len == 0 ? 0 : beg[j] + (std_fmemget(arr + beg[j]) < key[j]);
+      int_t found = idx < len ? std_fmemget(arr + idx) == key[j] : 0;
+      std_fmemset(dst + first + j, found ? idx : -1);
+      j = j + 1;
+    }
+
+    first = first + count;
+  }
+}
+
+// In-order traversal of the tree from node k: it visits the nodes in sorted
+// order, so the i-th node visited gets arr[i]
+// Returns the index in arr of the next item
+static int_t eytzinger_fill(int_t dst, int_t arr, int_t len, int_t i,
+                            int_t k) {
+  if (k > len)
+    return i;
+  i = eytzinger_fill(dst, arr, len, i, 2 * k);
+  std_fmemset(dst + k, std_fmemget(arr + i));
+  return eytzinger_fill(dst, arr, len, i + 1, 2 * k + 1);
+}
+
+void eytzinger_build(int_t dst, int_t arr, int_t len) {
+  eytzinger_fill(dst, arr, len, 0, 1);
+}
+
+// Walk down from the root: left if the node is >= key, right otherwise
+// The 16 nodes 4 levels below k are contiguous from 16k: prefetching them
+// hides the memory latency of the next levels
+// The lower bound is the last node where the walk went left: remove the
+// trailing right moves (1 bits) of k, and the last left move (0 bit)
+int_t eytzinger_lower_bound(int_t eyt, int_t len, int_t key) {
+  int_t k = 1;
+  while (k <= len) {
+    std_fmemprefetch(eyt + 16 * k);
+    k = 2 * k + (std_fmemget(eyt + k) < key);
+  }
+
+  while (k % 2)
+    k = k / 2;
+  return k / 2;
+}
@@ -0,0 +1,42 @@
+#ifndef BINSEARCH_H_
+#define BINSEARCH_H_
+
+#include "lestd.h"
+
+// Binary search algorithm
+// Return index of key in v, or -1 if not found
+// v must be sorted
+int_t rank(int_t arr, int_t len, int_t key);
+
+// Return the number of entries < key in v: index of key if it's in v,
+// otherwhise index where key should be inserted to keep v sorted
+// v must be sorted
+int_t lower_bound(int_t arr, int_t len, int_t key);
+
+// Same as lower_bound, without unpredictable branches: the search zone
+// always has the same length sequence whatever the key, only its start
+// depends on the comparisons (conditional move)
+int_t lower_bound_branchless(int_t arr, int_t len, int_t key);
+
+// Run rank for the `n` keys of the array keys, and write the results to the
+// array dst
+// The searches are interleaved: the memory accesses of the different keys
+// overlap instead of waiting for each other
+void rank_many(int_t arr, int_t len, int_t keys, int_t n, int_t dst);
+
+// Eytzinger layout: the sorted array is stored as a complete binary search
+// tree in BFS order: the root at index 1, the children of node k at 2k and
+// 2k + 1 (index 0 is unused)
+// The first levels of the tree share a few cache lines, and the nodes
+// searched after node k are contiguous: they can be prefetched
+
+// Write the `len` items of the sorted array arr to dst in Eytzinger layout
+// dst must have room for len + 1 items, and not overlap arr
+void eytzinger_build(int_t dst, int_t arr, int_t len);
+
+// Return the Eytzinger index (in [1, len]) of the first item >= key in eyt,
+// or 0 if all items are < key
+// To get data associated to the items, store it in Eytzinger layout too
+int_t eytzinger_lower_bound(int_t eyt, int_t len, int_t key);
+
+#endif //! BINSEARCH_H_
@@ -1,38 +1,6 @@
+#include "binsearch.h"
 #include "leio.h"
 
-// Binary search algorithm
-// Return index of key in v, or -1 if not found
-// v must be sorted
-int_t rank(int_t arr, int_t len, int_t key);
-
-// Algorithm:
-// Look at the miidle of the array:
-// If key lower, than key must be in lower half
-// If key bigger, than must be in upper half
-// This way search zone is halfed every iteration
-//
-// Complexity:
-// O(log(v.size())
-int_t rank(int_t arr, int_t len, int_t key) {
-  if (len == 0)
-    return -1;
-  int_t beg = 0;
-  int_t end = len - 1;
-
-  while (beg <= end) {
-    int_t mid = beg + (end - beg) / 2;
-    int_t mid_val = std_fmemget(arr + mid);
-    if (key < mid_val)
-      end = mid - 1;
-    else if (key > mid_val)
-      beg = mid + 1;
-    else
-      return mid;
-  }
-
-  return -1;
-}
-
 void test_empty() { printnl_int(rank(160, 0, 56)); }
 
 void test1() {
@@ -83,9 +51,113 @@ void test3() {
   printnl_int(rank(160, 10, 63));
 }
 
+void test4() {
+  printnl_int(lower_bound(160, 0, 56));
+
+  int_t i = 0;
+  while (i < 10) {
+    std_fmemset(160 + i, 2 * i - 5);
+    i += 1;
+  }
+
+  printnl_int(lower_bound(160, 10, -50));
+  i = -8;
+  while (i < 18) {
+    printnl_int(lower_bound(160, 10, i));
+    i += 1;
+  }
+  printnl_int(lower_bound(160, 10, 63));
+}
+
+void test5() {
+  printnl_int(lower_bound_branchless(160, 0, 56));
+
+  int_t len = 1;
+  while (len <= 12) {
+    int_t i = 0;
+    while (i < len) {
+      std_fmemset(160 + i, 2 * i - 5);
+      i += 1;
+    }
+
+    i = -8;
+    while (i < 2 * len) {
+      print_int(lower_bound_branchless(160, len, i));
+      std_putc(32);
+      i += 1;
+    }
+    printnl();
+    len += 1;
+  }
+}
+
+// Eytzinger layout: for every length, print the tree, and the lower bound
+// of every key (the item, or "-" if all items are < key)
+void test6() {
+  int_t len = 0;
+  while (len <= 12) {
+    int_t i = 0;
+    while (i < len) {
+      std_fmemset(160 + i, 2 * i - 5);
+      i += 1;
+    }
+    eytzinger_build(400, 160, len);
+
+    i = 1;
+    while (i <= len) {
+      print_int(std_fmemget(400 + i));
+      std_putc(32);
+      i += 1;
+    }
+    std_putc(59);
+
+    i = -8;
+    while (i < 2 * len) {
+      std_putc(32);
+      int_t k = eytzinger_lower_bound(400, len, i);
+      if (k == 0)
+        std_putc(45);
+      else
+        print_int(std_fmemget(400 + k));
+      i += 1;
+    }
+    printnl();
+    len += 1;
+  }
+}
+
+void test7() {
+  int_t i = 0;
+  while (i < 10) {
+    std_fmemset(160 + i, 2 * i);
+    i += 1;
+  }
+  i = 0;
+  while (i < 40) {
+    std_fmemset(600 + i, (i * 7) % 25 - 3);
+    i += 1;
+  }
+
+  rank_many(160, 10, 600, 40, 700);
+  i = 0;
+  while (i < 40) {
+    print_int(std_fmemget(700 + i));
+    std_putc(32);
+    i += 1;
+  }
+  printnl();
+
+  rank_many(160, 0, 600, 3, 700);
+  printnl_int(std_fmemget(700 + 2));
+}
+
 int main() {
   test_empty();
   test1();
   test2();
   test3();
+  test4();
+  test5();
+  test6();
+  test7();
 }
@@ -7,6 +7,10 @@ int rank(const std::vector<int> &arr, int key) {
   return it == arr.end() ? -1 : (it - arr.begin());
 }
 
+int lower_bound(const std::vector<int> &arr, int key) {
+  return std::lower_bound(arr.begin(), arr.end(), key) - arr.begin();
+}
+
 void test_empty() { std::cout << rank({}, 160) << std::endl; }
 
 void test1() {
@@ -42,9 +46,82 @@ void test3() {
   std::cout << rank(arr, 63) << std::endl;
 }
 
+void test4() {
+  std::cout << lower_bound({}, 56) << std::endl;
+
+  std::vector<int> arr;
+  for (int i = 0; i < 10; ++i)
+    arr.push_back(2 * i - 5);
+
+  std::cout << lower_bound(arr, -50) << std::endl;
+  for (int i = -8; i < 18; ++i)
+    std::cout << lower_bound(arr, i) << std::endl;
+  std::cout << lower_bound(arr, 63) << std::endl;
+}
+
+void test5() {
+  std::cout << 0 << std::endl;
+  for (int len = 1; len <= 12; ++len) {
+    std::vector<int> arr;
+    for (int i = 0; i < len; ++i)
+      arr.push_back(2 * i - 5);
+    for (int i = -8; i < 2 * len; ++i)
+      std::cout << lower_bound(arr, i) << " ";
+    std::cout << std::endl;
+  }
+}
+
+// Fill the Eytzinger layout with an in-order traversal
+int eytzinger_fill(std::vector<int> &eyt, const std::vector<int> &arr, int i,
+                   std::size_t k) {
+  if (k >= eyt.size())
+    return i;
+  i = eytzinger_fill(eyt, arr, i, 2 * k);
+  eyt[k] = arr[i];
+  return eytzinger_fill(eyt, arr, i + 1, 2 * k + 1);
+}
+
+void test6() {
+  for (int len = 0; len <= 12; ++len) {
+    std::vector<int> arr;
+    for (int i = 0; i < len; ++i)
+      arr.push_back(2 * i - 5);
+    std::vector<int> eyt(len + 1);
+    eytzinger_fill(eyt, arr, 0, 1);
+
+    for (int i = 1; i <= len; ++i)
+      std::cout << eyt[i] << " ";
+    std::cout << ";";
+
+    for (int i = -8; i < 2 * len; ++i) {
+      std::cout << " ";
+      auto it = std::lower_bound(arr.begin(), arr.end(), i);
+      if (it == arr.end())
+        std::cout << "-";
+      else
+        std::cout << *it;
+    }
+    std::cout << std::endl;
+  }
+}
+
+void test7() {
+  std::vector<int> arr;
+  for (int i = 0; i < 10; ++i)
+    arr.push_back(2 * i);
+  for (int i = 0; i < 40; ++i)
+    std::cout << rank(arr, (i * 7) % 25 - 3) << " ";
+  std::cout << std::endl;
+  std::cout << -1 << std::endl;
+}
+
 int main() {
   test_empty();
   test1();
   test2();
   test3();
+  test4();
+  test5();
+  test6();
+  test7();
 }
@@ -0,0 +1,96 @@
+// Multi-threaded benchmark of the concurrent queues
+// p producer threads push NB_ITEMS items in total through a bounded queue to p
+// consumer threads, for p = 1, 2, 4, ... up to BENCH_MAX_PAIRS
+//
+// Every item is its index: the producer stores the time it pushed it, the
+// consumer measures the time until it popped it (1 item out of 8 is sampled)
+// The latency includes the time spent waiting in the queue, so it grows with
+// the capacity when the consumers are slower than the producers
+
+extern "C" {
+#include "queue.h"
+}
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#ifndef BENCH_MAX_PAIRS
+#define BENCH_MAX_PAIRS (4)
+#endif
+
+namespace {
+
+using clk = std::chrono::steady_clock;
+
+constexpr int NB_ITEMS = 1000000;
+constexpr int SAMPLE = 8;
+
+std::int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             clk::now().time_since_epoch())
+      .count();
+}
+
+// Producer t pushes the items t, t + p, t + 2p, ...
+void producer(int_t q, std::vector<std::int64_t> &stamps, int t, int p) {
+  for (int i = t; i < NB_ITEMS; i += p) {
+    stamps[i] = now_ns();
+    queue_push(q, i);
+  }
+}
+
+void consumer(int_t q, const std::vector<std::int64_t> &stamps, int count,
+              std::vector<std::int64_t> &lats) {
+  for (int i = 0; i < count; ++i) {
+    int_t item = queue_pop(q);
+    if (item % SAMPLE == 0)
+      lats.push_back(now_ns() - stamps[item]);
+  }
+}
+
+void bench_pairs(int p, int cap) {
+  int_t q = queue_new_cap(cap);
+  std::vector<std::int64_t> stamps(NB_ITEMS);
+  std::vector<std::vector<std::int64_t>> lats(p);
+
+  auto start = clk::now();
+  std::vector<std::thread> pool;
+  for (int t = 0; t < p; ++t) {
+    int count = NB_ITEMS / p + (t < NB_ITEMS % p);
+    pool.emplace_back(consumer, q, std::cref(stamps), count,
+                      std::ref(lats[t]));
+  }
+  for (int t = 0; t < p; ++t)
+    pool.emplace_back(producer, q, std::ref(stamps), t, p);
+  for (auto &th : pool)
+    th.join();
+  double secs = std::chrono::duration<double>(clk::now() - start).count();
+
+  std::vector<std::int64_t> all;
+  for (auto &l : lats)
+    all.insert(all.end(), l.begin(), l.end());
+  std::sort(all.begin(), all.end());
+
+  std::cout << p << "\t" << p << "\t" << cap << "\t" << NB_ITEMS << "\t"
+            << secs * 1e3 << "\t" << NB_ITEMS / secs / 1e6 << "\t"
+            << all[all.size() / 2] << "\t" << all[all.size() * 99 / 100]
+            << std::endl;
+
+  queue_free(q);
+}
+
+} // namespace
+
+int main() {
+  std::cout << "producers\tconsumers\tcap\titems\ttime_ms\tMitems/s\tp50_ns\t"
+               "p99_ns"
+            << std::endl;
+  int caps[] = {64, 1024};
+  for (int cap : caps)
+    for (int p = 1; p <= BENCH_MAX_PAIRS; p *= 2)
+      bench_pairs(p, cap);
+}
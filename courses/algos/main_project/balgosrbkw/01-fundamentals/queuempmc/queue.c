@@ -0,0 +1,172 @@
+#include "queue.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// Implementation based on a circular array of fixed capacity, where every
+// slot has a sequence number (Vyukov bounded MPMC queue)
+// The back index (tail) and front index (head) only increase (modulo 2^32),
+// the slot of index i is i % cap.
+// The sequence number of a slot tells who can use it:
+// - seq == i: empty, ready for the push of index i
+// - seq == i + 1: full, ready for the pop of index i
+// A push claims index i = tail by incrementing tail with a compare-and-swap
+// (CAS), writes the item, then sets seq to i + 1 (atomic store, release).
+// A pop claims index i = head the same way, reads the item, then sets seq to
+// i + cap: the slot is ready for the push of the next round.
+// If seq is behind the index, the queue is full (push) or empty (pop).
+// Threads only wait for each other on the same slot, never on a lock.
+//
+// tail and head are on different cache lines, so producers and consumers
+// don't invalidate each other's line at every operation.
+//
+// Memory layout: LINE_WORDS words per cache line, q is aligned on a line
+// - q[0]: capacity
+// - q[1]: slots array: seq, item
+// - q[2]: allocated block, q is the first line start in it
+// - q[LINE_WORDS]: head
+// - q[2 * LINE_WORDS]: tail
+
+#define LINE_WORDS (STD_FMEM_LINE_WORDS)
+#define DEFAULT_CAP (1024)
+#define SPIN_LIMIT (64)
+
+// Returns the first address >= addr which starts a cache line
+static int_t line_align(int_t addr) {
+  return (addr + LINE_WORDS - 1) / LINE_WORDS * LINE_WORDS;
+}
+
+static int_t head_addr(int_t q) { return q + LINE_WORDS; }
+
+static int_t tail_addr(int_t q) { return q + 2 * LINE_WORDS; }
+
+// Indices wrap around modulo 2^32
+static int_t idx_add(int_t idx, int_t n) {
+  return (int_t)((uint32_t)idx + (uint32_t)n);
+}
+
+static int_t idx_diff(int_t a, int_t b) {
+  return (int_t)((uint32_t)a - (uint32_t)b);
+}
+
+static int_t slot_addr(int_t q, int_t idx) {
+  uint32_t mask = (uint32_t)std_fmemget(q) - 1u;
+  return std_fmemget(q + 1) + 2 * (int_t)((uint32_t)idx & mask);
+}
+
+// Wait for `spins` iterations of a spin loop
+// After SPIN_LIMIT iterations, the thread we're waiting for may not be
+// running, let it run
+static int_t spin_wait(int_t spins) {
+  if (spins < SPIN_LIMIT)
+    return spins + 1;
+  std_yield();
+  return 0;
+}
+
+int_t queue_new() { return queue_new_cap(DEFAULT_CAP); }
+
+// At least 2 slots: with 1 slot, the sequence number of a full slot (i + 1)
+// would also be the one of an empty slot for the next push (i + cap)
+int_t queue_new_cap(int_t cap) {
+  int_t real_cap = 2;
+  while (real_cap < cap)
+    real_cap = 2 * real_cap;
+
+  int_t block = fm_alloc(4 * LINE_WORDS - 1);
+  int_t q = line_align(block);
+  int_t slots = fm_alloc(2 * real_cap);
+  std_fmemset(q, real_cap);
+  std_fmemset(q + 2, block);
+  std_fmemset(q + 1, slots);
+  std_fmemset(head_addr(q), 0);
+  std_fmemset(tail_addr(q), 0);
+
+  int_t i = 0;
+  while (i < real_cap) {
+    std_fmemset(slots + 2 * i, i);
+    i = i + 1;
+  }
+  return q;
+}
+
+void queue_free(int_t q) {
+  fm_free(std_fmemget(q + 1));
+  fm_free(std_fmemget(q + 2));
+}
+
+int_t queue_size(int_t q) {
+  int_t head = std_fmemload(head_addr(q));
+  int_t size = idx_diff(std_fmemload(tail_addr(q)), head);
+  return size < 0 ? 0 : size;
+}
+
+// Claim the index `tail` or `head` (at `idx_addr`) for an operation which
+// needs the slot sequence number to be idx + `ready`
+// Returns the address of the claimed slot, or 0 if the slot isn't ready (queue
+// full or empty)
+static int_t claim(int_t q, int_t idx_addr, int_t ready) {
+  int_t idx = std_fmemload(idx_addr);
+  while (1) {
+    int_t slot = slot_addr(q, idx);
+    int_t dif = idx_diff(std_fmemload(slot), idx_add(idx, ready));
+    if (dif == 0) {
+      if (std_fmemcas(idx_addr, idx, idx_add(idx, 1)))
+        return slot;
+      idx = std_fmemload(idx_addr);
+    } else if (dif < 0) {
+      return 0;
+    } else {
+      // Another thread claimed idx meanwhile
+      idx = std_fmemload(idx_addr);
+    }
+  }
+}
+
+// The slot sequence number is idx: it becomes idx + 1
+static void push_item(int_t slot, int_t val) {
+  std_fmemset(slot + 1, val);
+  std_fmemstore(slot, idx_add(std_fmemget(slot), 1));
+}
+
+// The slot sequence number is idx + 1: it becomes idx + cap
+static int_t pop_item(int_t q, int_t slot) {
+  int_t val = std_fmemget(slot + 1);
+  std_fmemstore(slot, idx_add(std_fmemget(slot), std_fmemget(q) - 1));
+  return val;
+}
+
+int_t queue_try_push(int_t q, int_t val) {
+  int_t slot = claim(q, tail_addr(q), 0);
+  if (slot == 0)
+    return 0;
+  push_item(slot, val);
+  return 1;
+}
+
+int_t queue_try_pop(int_t q, int_t dst) {
+  int_t slot = claim(q, head_addr(q), 1);
+  if (slot == 0)
+    return 0;
+  std_fmemset(dst, pop_item(q, slot));
+  return 1;
+}
+
+void queue_push(int_t q, int_t val) {
+  int_t spins = 0;
+  int_t slot = claim(q, tail_addr(q), 0);
+  while (slot == 0) {
+    spins = spin_wait(spins);
+    slot = claim(q, tail_addr(q), 0);
+  }
+  push_item(slot, val);
+}
+
+int_t queue_pop(int_t q) {
+  int_t spins = 0;
+  int_t slot = claim(q, head_addr(q), 1);
+  while (slot == 0) {
+    spins = spin_wait(spins);
+    slot = claim(q, head_addr(q), 1);
+  }
+  return pop_item(q, slot);
+}
@@ -0,0 +1,104 @@
+#include <iostream>
+#include <vector>
+
+void test1() {
+  std::vector<int> q;
+  std::cout << q.size() << std::endl;
+
+  q.push_back(10);
+  q.push_back(18);
+  q.push_back(23);
+  q.push_back(45);
+
+  while (q.size()) {
+    std::cout << q.front() << std::endl;
+    q.erase(q.begin());
+  }
+}
+
+void test2() {
+  std::vector<int> q;
+
+  q.push_back(18);
+  q.push_back(25);
+  q.push_back(16);
+  q.push_back(56);
+  std::cout << q.front() << std::endl;
+  q.erase(q.begin());
+  std::cout << q.front() << std::endl;
+  q.erase(q.begin());
+
+  q.push_back(12);
+  std::cout << q.front() << std::endl;
+  q.erase(q.begin());
+  std::cout << q.front() << std::endl;
+  q.erase(q.begin());
+
+  q.push_back(24);
+  q.push_back(8);
+  q.push_back(-34);
+  std::cout << q.front() << std::endl;
+  q.erase(q.begin());
+  std::cout << q.front() << std::endl;
+  q.erase(q.begin());
+}
+
+void test3() {
+  std::vector<int> q;
+  for (int i = 0; i < 1000; ++i)
+    q.push_back(3 * i * i + 2 * i - 134);
+
+  while (q.size()) {
+    std::cout << q.front() << std::endl;
+    q.erase(q.begin());
+  }
+}
+
+void test4() {
+  std::vector<int> q;
+  for (int i = 0; i < 10; ++i) {
+    std::cout << (i < 8);
+    if (i < 8)
+      q.push_back(10 * i);
+  }
+  std::cout << std::endl;
+  std::cout << q.size() << std::endl;
+
+  for (int val : q)
+    std::cout << val << std::endl;
+  std::cout << 0 << std::endl;
+
+  for (int i = 0; i < 100; ++i)
+    std::cout << i << -i << 2 * i;
+  std::cout << std::endl;
+}
+
+void test_cap1() {
+  std::cout << 110 << std::endl;
+  std::cout << 2 << std::endl;
+  int front[] = {5, 6};
+  for (int i = 0; i < 10; ++i) {
+    std::cout << 1 << front[i % 2] << 1 << " ";
+    front[i % 2] = 8 + i;
+  }
+  std::cout << std::endl;
+  std::cout << 2 << std::endl;
+}
+
+void test5() {
+  for (int p = 1; p <= 4; p *= 2) {
+    long total = p * (20000 / p);
+    std::cout << total * (total - 1) / 2 << std::endl;
+    std::cout << p << std::endl;
+    std::cout << 0 << std::endl;
+  }
+}
+
+int main() {
+  test1();
+  test2();
+  test3();
+  test4();
+  test_cap1();
+  test5();
+}
@@ -0,0 +1,103 @@
+#include "queue.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// Implementation based on a circular array (ring buffer)
+// The items are in the array from index head, wrapping around at the end of
+// the array
+// The capacity is a power of 2, doubled when full, and never reduced
+// => once the queue reached its largest size, push and pop never allocate
+//
+// Memory layout:
+// - q[0]: capacity
+// - q[1]: index of the front item
+// - q[2]: number of items
+// - q[3]: items array
+
+#define MIN_CAP (8)
+
+// Address of the item at position i from the front
+static int_t item_addr(int_t q, int_t i) {
+  int_t cap = std_fmemget(q);
+  return std_fmemget(q + 3) + ((std_fmemget(q + 1) + i) & (cap - 1));
+}
+
+// Double the capacity: copy the 2 parts of the items (from head to the end of
+// the array, then from the start of the array), to the start of a new array
+static void queue_grow(int_t q) {
+  int_t cap = std_fmemget(q);
+  int_t head = std_fmemget(q + 1);
+  int_t arr = std_fmemget(q + 3);
+  int_t new_arr = fm_alloc(2 * cap);
+
+  std_fmemcpy(new_arr, arr + head, cap - head);
+  std_fmemcpy(new_arr + cap - head, arr, head);
+  fm_free(arr);
+
+  std_fmemset(q, 2 * cap);
+  std_fmemset(q + 1, 0);
+  std_fmemset(q + 3, new_arr);
+}
+
+int_t queue_new() {
+  int_t q = fm_alloc(4);
+  std_fmemset(q, MIN_CAP);
+  std_fmemset(q + 1, 0);
+  std_fmemset(q + 2, 0);
+  std_fmemset(q + 3, fm_alloc(MIN_CAP));
+  return q;
+}
+
+void queue_free(int_t q) {
+  fm_free(std_fmemget(q + 3));
+  fm_free(q);
+}
+
+int_t queue_size(int_t q) { return std_fmemget(q + 2); }
+
+void queue_push(int_t q, int_t val) {
+  int_t size = queue_size(q);
+  if (size == std_fmemget(q))
+    queue_grow(q);
+
+  std_fmemset(item_addr(q, size), val);
+  std_fmemset(q + 2, size + 1);
+}
+
+int_t queue_pop(int_t q) {
+  int_t size = queue_size(q);
+  panic_ifn(size > 0);
+  int_t res = std_fmemget(item_addr(q, 0));
+
+  std_fmemset(q + 1, (std_fmemget(q + 1) + 1) & (std_fmemget(q) - 1));
+  std_fmemset(q + 2, size - 1);
+  return res;
+}
+
+void queue_push_front(int_t q, int_t val) {
+  int_t size = queue_size(q);
+  if (size == std_fmemget(q))
+    queue_grow(q);
+
+  int_t cap = std_fmemget(q);
+  std_fmemset(q + 1, (std_fmemget(q + 1) + cap - 1) & (cap - 1));
+  std_fmemset(item_addr(q, 0), val);
+  std_fmemset(q + 2, size + 1);
+}
+
+int_t queue_pop_back(int_t q) {
+  int_t size = queue_size(q);
+  panic_ifn(size > 0);
+  std_fmemset(q + 2, size - 1);
+  return std_fmemget(item_addr(q, size - 1));
+}
+
+int_t queue_front(int_t q) {
+  panic_ifn(queue_size(q) > 0);
+  return std_fmemget(item_addr(q, 0));
+}
+
+int_t queue_back(int_t q) {
+  panic_ifn(queue_size(q) > 0);
+  return std_fmemget(item_addr(q, queue_size(q) - 1));
+}
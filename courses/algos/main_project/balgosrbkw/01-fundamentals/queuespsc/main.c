@@ -0,0 +1,140 @@
+#include "lealloc.h"
+#include "leio.h"
+#include "queue.h"
+
+void test1() {
+  int_t q = queue_new();
+  printnl_int(queue_size(q));
+
+  queue_push(q, 10);
+  queue_push(q, 18);
+  queue_push(q, 23);
+  queue_push(q, 45);
+
+  while (queue_size(q)) {
+    printnl_int(queue_pop(q));
+  }
+
+  queue_free(q);
+}
+
+void test2() {
+  int_t q = queue_new();
+
+  queue_push(q, 18);
+  queue_push(q, 25);
+  queue_push(q, 16);
+  queue_push(q, 56);
+  printnl_int(queue_pop(q));
+  printnl_int(queue_pop(q));
+
+  queue_push(q, 12);
+  printnl_int(queue_pop(q));
+  printnl_int(queue_pop(q));
+
+  queue_push(q, 24);
+  queue_push(q, 8);
+  queue_push(q, -34);
+  printnl_int(queue_pop(q));
+  printnl_int(queue_pop(q));
+
+  queue_free(q);
+}
+
+void test3() {
+  int_t q = queue_new();
+  int_t i = 0;
+  while (i < 1000) {
+    queue_push(q, 3 * i * i + 2 * i - 134);
+    i += 1;
+  }
+
+  while (queue_size(q)) {
+    printnl_int(queue_pop(q));
+  }
+
+  queue_free(q);
+}
+
+// Bounded queue: full and empty, and indices wrapping around the array
+void test4() {
+  int_t q = queue_new_cap(5);
+  int_t dst = fm_alloc(1);
+  int_t i = 0;
+  while (i < 10) {
+    print_int(queue_try_push(q, 10 * i));
+    i = i + 1;
+  }
+  printnl();
+  printnl_int(queue_size(q));
+
+  while (queue_try_pop(q, dst))
+    printnl_int(std_fmemget(dst));
+  printnl_int(queue_size(q));
+
+  i = 0;
+  while (i < 100) {
+    queue_push(q, i);
+    queue_push(q, -i);
+    queue_push(q, 2 * i);
+    print_int(queue_pop(q));
+    print_int(queue_pop(q));
+    print_int(queue_pop(q));
+    i = i + 1;
+  }
+  printnl();
+
+  fm_free(dst);
+  queue_free(q);
+}
+
+// Context of the threads of test5:
+// - ctx[0]: queue
+// - ctx[1]: number of items
+// - ctx[2]: sum of the popped items
+// - ctx[3]: 1 if the items were popped in order
+
+// Thread 0 pushes 0 .. n-1, thread 1 pops them
+void producer_consumer(int_t ctx, int_t idx) {
+  int_t q = std_fmemget(ctx);
+  int_t n = std_fmemget(ctx + 1);
+  int_t i = 0;
+  if (idx == 0) {
+    while (i < n) {
+      queue_push(q, i);
+      i = i + 1;
+    }
+  } else {
+    int_t sum = 0;
+    int_t in_order = 1;
+    while (i < n) {
+      int_t val = queue_pop(q);
+      in_order = in_order && val == i;
+      sum = sum + val;
+      i = i + 1;
+    }
+    std_fmemset(ctx + 2, sum);
+    std_fmemset(ctx + 3, in_order);
+  }
+}
+
+// One producer thread, one consumer thread
+void test5() {
+  int_t ctx = fm_alloc(4);
+  std_fmemset(ctx, queue_new_cap(64));
+  std_fmemset(ctx + 1, 50000);
+  std_parallel(2, producer_consumer, ctx);
+  printnl_int(std_fmemget(ctx + 2));
+  printnl_int(std_fmemget(ctx + 3));
+  printnl_int(queue_size(std_fmemget(ctx)));
+  queue_free(std_fmemget(ctx));
+  fm_free(ctx);
+}
+
+int main() {
+  test1();
+  test2();
+  test3();
+  test4();
+  test5();
+}
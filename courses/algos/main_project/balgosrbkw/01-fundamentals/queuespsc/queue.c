@@ -0,0 +1,141 @@
+#include "queue.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// Implementation based on a circular array (ring buffer) of fixed capacity
+// The front index (head) is only written by the consumer, and the back index
+// (tail) only by the producer:
+// - the producer writes the item, then publishes it by incrementing tail
+// (atomic store, release)
+// - the consumer reads the item, then frees its slot by incrementing head
+// The indices only increase (modulo 2^32), the slot of index i is i % cap.
+//
+// head and tail are on different cache lines, so the producer and the
+// consumer don't invalidate each other's line at every operation.
+// Every thread also keeps a cached copy of the other index on its own line,
+// and reads the shared one only when the cached copy says the queue is
+// full (producer) or empty (consumer).
+//
+// Memory layout: LINE_WORDS words per cache line, q is aligned on a line
+// - q[0]: capacity
+// - q[1]: items array
+// - q[2]: allocated block, q is the first line start in it
+// - q[LINE_WORDS]: head
+// - q[LINE_WORDS + 1]: cached tail (consumer)
+// - q[2 * LINE_WORDS]: tail
+// - q[2 * LINE_WORDS + 1]: cached head (producer)
+
+#define LINE_WORDS (STD_FMEM_LINE_WORDS)
+#define DEFAULT_CAP (1024)
+#define SPIN_LIMIT (64)
+
+// Returns the first address >= addr which starts a cache line
+static int_t line_align(int_t addr) {
+  return (addr + LINE_WORDS - 1) / LINE_WORDS * LINE_WORDS;
+}
+
+static int_t head_addr(int_t q) { return q + LINE_WORDS; }
+
+static int_t tail_addr(int_t q) { return q + 2 * LINE_WORDS; }
+
+// Indices wrap around modulo 2^32
+static int_t idx_next(int_t idx) { return (int_t)((uint32_t)idx + 1u); }
+
+static int_t idx_diff(int_t a, int_t b) {
+  return (int_t)((uint32_t)a - (uint32_t)b);
+}
+
+static int_t slot_addr(int_t q, int_t idx) {
+  uint32_t mask = (uint32_t)std_fmemget(q) - 1u;
+  return std_fmemget(q + 1) + (int_t)((uint32_t)idx & mask);
+}
+
+// Wait for `spins` iterations of a spin loop
+// After SPIN_LIMIT iterations, the other thread may not be running, let it run
+static int_t spin_wait(int_t spins) {
+  if (spins < SPIN_LIMIT)
+    return spins + 1;
+  std_yield();
+  return 0;
+}
+
+int_t queue_new() { return queue_new_cap(DEFAULT_CAP); }
+
+int_t queue_new_cap(int_t cap) {
+  int_t real_cap = 1;
+  while (real_cap < cap)
+    real_cap = 2 * real_cap;
+
+  int_t block = fm_alloc(4 * LINE_WORDS - 1);
+  int_t q = line_align(block);
+  std_fmemset(q, real_cap);
+  std_fmemset(q + 2, block);
+  std_fmemset(q + 1, fm_alloc(real_cap));
+  std_fmemset(head_addr(q), 0);
+  std_fmemset(head_addr(q) + 1, 0);
+  std_fmemset(tail_addr(q), 0);
+  std_fmemset(tail_addr(q) + 1, 0);
+  return q;
+}
+
+void queue_free(int_t q) {
+  fm_free(std_fmemget(q + 1));
+  fm_free(std_fmemget(q + 2));
+}
+
+int_t queue_size(int_t q) {
+  int_t head = std_fmemload(head_addr(q));
+  return idx_diff(std_fmemload(tail_addr(q)), head);
+}
+
+int_t queue_try_push(int_t q, int_t val) {
+  int_t tail = std_fmemget(tail_addr(q));
+  if (idx_diff(tail, std_fmemget(tail_addr(q) + 1)) == std_fmemget(q)) {
+    std_fmemset(tail_addr(q) + 1, std_fmemload(head_addr(q)));
+    if (idx_diff(tail, std_fmemget(tail_addr(q) + 1)) == std_fmemget(q))
+      return 0;
+  }
+
+  std_fmemset(slot_addr(q, tail), val);
+  std_fmemstore(tail_addr(q), idx_next(tail));
+  return 1;
+}
+
+// Returns 1 if there is an item to pop
+static int_t can_pop(int_t q) {
+  int_t head = std_fmemget(head_addr(q));
+  if (head == std_fmemget(head_addr(q) + 1)) {
+    std_fmemset(head_addr(q) + 1, std_fmemload(tail_addr(q)));
+    if (head == std_fmemget(head_addr(q) + 1))
+      return 0;
+  }
+  return 1;
+}
+
+// Pop the front item, there must be one
+static int_t pop_item(int_t q) {
+  int_t head = std_fmemget(head_addr(q));
+  int_t val = std_fmemget(slot_addr(q, head));
+  std_fmemstore(head_addr(q), idx_next(head));
+  return val;
+}
+
+int_t queue_try_pop(int_t q, int_t dst) {
+  if (can_pop(q) == 0)
+    return 0;
+  std_fmemset(dst, pop_item(q));
+  return 1;
+}
+
+void queue_push(int_t q, int_t val) {
+  int_t spins = 0;
+  while (queue_try_push(q, val) == 0)
+    spins = spin_wait(spins);
+}
+
+int_t queue_pop(int_t q) {
+  int_t spins = 0;
+  while (can_pop(q) == 0)
+    spins = spin_wait(spins);
+  return pop_item(q);
+}
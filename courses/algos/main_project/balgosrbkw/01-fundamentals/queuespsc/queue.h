@@ -0,0 +1,41 @@
+#ifndef QUEUE_H_
+#define QUEUE_H_
+
+#include "lestd.h"
+
+// Bounded concurrent queue
+// One thread can push and another one pop at the same time, without locks
+// (single-producer / single-consumer)
+
+// Create a new empty queue, with the default capacity
+int_t queue_new();
+
+// Create a new empty queue, for at most `cap` items
+// cap is rounded up to a power of 2
+int_t queue_new_cap(int_t cap);
+
+// Free all memory allocated to a queue
+void queue_free(int_t q);
+
+// Returns the number of items in the queue
+// While other threads use the queue, it may be outdated as soon as returned
+int_t queue_size(int_t q);
+
+// Push one item to the back of the queue
+// Wait until there is room if the queue is full
+void queue_push(int_t q, int_t val);
+
+// Pop and returns one item from the front of the queue
+// Wait until there is an item if the queue is empty
+int_t queue_pop(int_t q);
+
+// Push one item to the back of the queue, if it's not full
+// Returns 1 if the item was pushed, 0 if the queue is full
+int_t queue_try_push(int_t q, int_t val);
+
+// Pop one item from the front of the queue, if it's not empty, and write it at
+// address dst
+// Returns 1 if an item was popped, 0 if the queue is empty
+int_t queue_try_pop(int_t q, int_t dst);
+
+#endif //! QUEUE_H_
@@ -0,0 +1,103 @@
+#include "leio.h"
+#include "queue.h"
+
+void test1() {
+  int_t q = queue_new();
+  printnl_int(queue_size(q));
+
+  queue_push(q, 10);
+  queue_push(q, 18);
+  queue_push(q, 23);
+  queue_push(q, 45);
+
+  while (queue_size(q)) {
+    printnl_int(queue_pop(q));
+  }
+
+  queue_free(q);
+}
+
+void test2() {
+  int_t q = queue_new();
+
+  queue_push(q, 18);
+  queue_push(q, 25);
+  queue_push(q, 16);
+  queue_push(q, 56);
+  printnl_int(queue_pop(q));
+  printnl_int(queue_pop(q));
+
+  queue_push(q, 12);
+  printnl_int(queue_pop(q));
+  printnl_int(queue_pop(q));
+
+  queue_push(q, 24);
+  queue_push(q, 8);
+  queue_push(q, -34);
+  printnl_int(queue_pop(q));
+  printnl_int(queue_pop(q));
+
+  queue_free(q);
+}
+
+void test3() {
+  int_t q = queue_new();
+  int_t i = 0;
+  while (i < 1000) {
+    queue_push(q, 3 * i * i + 2 * i - 134);
+    i += 1;
+  }
+
+  while (queue_size(q)) {
+    printnl_int(queue_pop(q));
+  }
+
+  queue_free(q);
+}
+
+// Pushes and pops across block boundaries, and emptying the queue
+void test4() {
+  int_t q = queue_new();
+  int_t i = 0;
+  while (i < 300) {
+    queue_push(q, i);
+    if (i % 3 == 0) {
+      print_int(queue_pop(q));
+      std_putc(32);
+    }
+    i = i + 1;
+  }
+  printnl();
+  printnl_int(queue_size(q));
+
+  while (queue_size(q)) {
+    print_int(queue_pop(q));
+    std_putc(32);
+  }
+  printnl();
+
+  int_t round = 1;
+  while (round < 70) {
+    i = 0;
+    while (i < round) {
+      queue_push(q, round * i);
+      i = i + 1;
+    }
+    int_t sum = 0;
+    while (queue_size(q))
+      sum = sum + queue_pop(q);
+    print_int(sum);
+    std_putc(32);
+    round = round + 7;
+  }
+  printnl();
+
+  queue_free(q);
+}
+
+int main() {
+  test1();
+  test2();
+  test3();
+  test4();
+}
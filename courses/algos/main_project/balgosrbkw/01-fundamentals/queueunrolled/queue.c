@@ -0,0 +1,111 @@
+#include "queue.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// Implementation based on an unrolled linked list
+// Same as queuell, but every node holds a block of up to BLOCK_SIZE values
+// => one link and one allocation for BLOCK_SIZE values instead of one per
+// value, and consecutive pushes / pops stay in the same block
+//
+// Items are pushed at index tail of the last node, and popped at index head
+// of the first node. All nodes in between are full.
+// When the first node is emptied, it's kept as a spare instead of being freed,
+// and reused by the next push which needs a new node.
+//
+// Memory layout:
+// - q[0]: first node (or 0 if empty)
+// - q[1]: last node (or 0 if empty)
+// - q[2]: number of items
+// - q[3]: head: index of the front item in the first node
+// - q[4]: tail: index after the back item in the last node
+// - q[5]: spare node (or 0)
+//
+// Node layout: next, vals[BLOCK_SIZE]
+
+#define BLOCK_SIZE (32)
+
+// Returns a node with no next node, the spare one if any
+static int_t node_new(int_t q) {
+  int_t node = std_fmemget(q + 5);
+  if (node)
+    std_fmemset(q + 5, 0);
+  else
+    node = fm_alloc(1 + BLOCK_SIZE);
+  std_fmemset(node, 0);
+  return node;
+}
+
+int_t queue_new() {
+  int_t q = fm_alloc(6);
+  std_fmemset(q, 0);
+  std_fmemset(q + 1, 0);
+  std_fmemset(q + 2, 0);
+  std_fmemset(q + 3, 0);
+  std_fmemset(q + 4, 0);
+  std_fmemset(q + 5, 0);
+  return q;
+}
+
+void queue_free(int_t q) {
+  int_t node = std_fmemget(q);
+  while (node) {
+    int_t next = std_fmemget(node);
+    fm_free(node);
+    node = next;
+  }
+
+  if (std_fmemget(q + 5))
+    fm_free(std_fmemget(q + 5));
+  fm_free(q);
+}
+
+int_t queue_size(int_t q) { return std_fmemget(q + 2); }
+
+void queue_push(int_t q, int_t val) {
+  int_t last = std_fmemget(q + 1);
+  int_t tail = std_fmemget(q + 4);
+
+  if (last == 0) {
+    last = node_new(q);
+    std_fmemset(q, last);
+    std_fmemset(q + 1, last);
+    std_fmemset(q + 3, 0);
+    tail = 0;
+  } else if (tail == BLOCK_SIZE) {
+    int_t node = node_new(q);
+    std_fmemset(last, node);
+    std_fmemset(q + 1, node);
+    last = node;
+    tail = 0;
+  }
+
+  std_fmemset(last + 1 + tail, val);
+  std_fmemset(q + 4, tail + 1);
+  std_fmemset(q + 2, std_fmemget(q + 2) + 1);
+}
+
+// When the first node gets empty, it replaces the spare node
+int_t queue_pop(int_t q) {
+  int_t first = std_fmemget(q);
+  panic_ifn(first);
+  int_t head = std_fmemget(q + 3);
+  int_t res = std_fmemget(first + 1 + head);
+  head = head + 1;
+
+  int_t size = std_fmemget(q + 2) - 1;
+  std_fmemset(q + 2, size);
+
+  if (size == 0 || head == BLOCK_SIZE) {
+    int_t next = std_fmemget(first);
+    std_fmemset(q, next);
+    if (next == 0)
+      std_fmemset(q + 1, 0);
+    if (std_fmemget(q + 5))
+      fm_free(std_fmemget(q + 5));
+    std_fmemset(q + 5, first);
+    head = 0;
+  }
+
+  std_fmemset(q + 3, head);
+  return res;
+}
@@ -0,0 +1,98 @@
+// Benchmark of the binary search variants
+// Sorted array of n distinct even keys, NB_QUERIES random lookups: half of
+// them hit, half miss (odd keys)
+// All variants answer the same queries, the checksum of the results must be
+// the same for lower_bound, lower_bound_branchless and eytzinger (mapped back
+// to the item), and for rank and rank_many
+
+extern "C" {
+#include "binsearch.h"
+#include "lealloc.h"
+}
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+namespace {
+
+using clk = std::chrono::steady_clock;
+
+constexpr int NB_QUERIES = 1000000;
+
+void report(const char *name, int n, double secs, long checksum) {
+  std::cout << name << "\t" << n << "\t" << NB_QUERIES << "\t" << secs * 1e3
+            << "\t" << NB_QUERIES / secs / 1e6 << "\t" << checksum
+            << std::endl;
+}
+
+// keys and dst are arrays of NB_QUERIES items
+// fm_free doesn't free memory (lealloc_v0): they are shared by all sizes
+void bench_size(int n, int_t keys, int_t dst) {
+  int_t arr = fm_alloc(n);
+  int_t eyt = fm_alloc(n + 1);
+  for (int i = 0; i < n; ++i)
+    std_fmemset(arr + i, 2 * i);
+  eytzinger_build(eyt, arr, n);
+
+  std::mt19937 rng(n);
+  std::uniform_int_distribution<std::int32_t> key(0, 2 * n - 1);
+  for (int i = 0; i < NB_QUERIES; ++i)
+    std_fmemset(keys + i, key(rng));
+
+  long sum = 0;
+  auto start = clk::now();
+  for (int i = 0; i < NB_QUERIES; ++i)
+    sum += rank(arr, n, std_fmemget(keys + i));
+  report("rank", n, std::chrono::duration<double>(clk::now() - start).count(),
+         sum);
+
+  sum = 0;
+  start = clk::now();
+  rank_many(arr, n, keys, NB_QUERIES, dst);
+  for (int i = 0; i < NB_QUERIES; ++i)
+    sum += std_fmemget(dst + i);
+  report("rank_many", n,
+         std::chrono::duration<double>(clk::now() - start).count(), sum);
+
+  sum = 0;
+  start = clk::now();
+  for (int i = 0; i < NB_QUERIES; ++i)
+    sum += lower_bound(arr, n, std_fmemget(keys + i));
+  report("lower_bound", n,
+         std::chrono::duration<double>(clk::now() - start).count(), sum);
+
+  sum = 0;
+  start = clk::now();
+  for (int i = 0; i < NB_QUERIES; ++i)
+    sum += lower_bound_branchless(arr, n, std_fmemget(keys + i));
+  report("branchless", n,
+         std::chrono::duration<double>(clk::now() - start).count(), sum);
+
+  // Items are 2 * index: the lower bound index is item / 2
+  sum = 0;
+  start = clk::now();
+  for (int i = 0; i < NB_QUERIES; ++i) {
+    int_t k = eytzinger_lower_bound(eyt, n, std_fmemget(keys + i));
+    sum += k ? std_fmemget(eyt + k) / 2 : n;
+  }
+  report("eytzinger", n,
+         std::chrono::duration<double>(clk::now() - start).count(), sum);
+
+  fm_free(eyt);
+  fm_free(arr);
+}
+
+} // namespace
+
+int main() {
+  std::cout << "impl\tn\tqueries\ttime_ms\tMqueries/s\tchecksum" << std::endl;
+  int_t keys = fm_alloc(NB_QUERIES);
+  int_t dst = fm_alloc(NB_QUERIES);
+  int sizes[] = {1000, 100000, 1000000, 4000000};
+  for (int n : sizes)
+    bench_size(n, keys, dst);
+  fm_free(dst);
+  fm_free(keys);
+}
@@ -1,3 +1,4 @@
+#include "lealloc.h"
 #include "leio.h"
 #include "stack.h"
 
@@ -30,7 +31,99 @@ void test2() {
   stack_free(s);
 }
 
+// Batch operations
+void test3() {
+  int_t s = stack_new();
+  int_t src = fm_alloc(100);
+  int_t dst = fm_alloc(100);
+  int_t i = 0;
+  while (i < 100) {
+    std_fmemset(src + i, 3 * i - 50);
+    i = i + 1;
+  }
+
+  stack_push(s, 7);
+  stack_push_many(s, src, 100);
+  printnl_int(stack_size(s));
+  printnl_int(stack_peek(s));
+
+  stack_pop_many(s, dst, 30);
+  i = 0;
+  while (i < 30) {
+    print_int(std_fmemget(dst + i));
+    std_putc(32);
+    i = i + 1;
+  }
+  printnl();
+  printnl_int(stack_size(s));
+  printnl_int(stack_peek(s));
+
+  stack_pop_many(s, dst, 0);
+  stack_pop_many(s, dst, 71);
+  printnl_int(std_fmemget(dst));
+  printnl_int(std_fmemget(dst + 70));
+  printnl_int(stack_size(s));
+
+  stack_push_many(s, src + 10, 5);
+  stack_push(s, 1000);
+  printnl_int(stack_pop(s));
+  printnl_int(stack_peek(s));
+  stack_clear(s);
+  printnl_int(stack_size(s));
+  stack_push(s, 5);
+  printnl_int(stack_peek(s));
+
+  fm_free(src);
+  fm_free(dst);
+  stack_free(s);
+}
+
+// Capacity: reserve, clear, and shrink policy
+void test4() {
+  int_t s = stack_new();
+  stack_set_shrink(s, 0);
+  int_t i = 0;
+  while (i < 1000) {
+    stack_push(s, i);
+    i = i + 1;
+  }
+  while (stack_size(s))
+    stack_pop(s);
+  printnl_int(stack_cap(s));
+
+  stack_reserve(s, 5000);
+  stack_push(s, 1);
+  stack_clear(s);
+  printnl_int(stack_cap(s));
+
+  // Oscillating around a power of 2: no resize without shrinking
+  i = 0;
+  while (i < 1000) {
+    stack_push(s, i);
+    stack_pop(s);
+    i = i + 1;
+  }
+  printnl_int(stack_cap(s));
+
+  stack_set_shrink(s, 4);
+  i = 0;
+  while (i < 10) {
+    stack_push(s, i);
+    i = i + 1;
+  }
+  printnl_int(stack_pop(s));
+  printnl_int(stack_cap(s));
+  while (stack_size(s) > 2)
+    stack_pop(s);
+  printnl_int(stack_cap(s));
+  printnl_int(stack_peek(s));
+
+  stack_free(s);
+}
+
 int main() {
   test1();
   test2();
+  test3();
+  test4();
 }
@@ -1,54 +1,65 @@
 #include "stack.h"
-#include "lealloc.h"
 #include "ledebug.h"
+#include "vector.h"
 
-static void stack_resize(int_t stack, int_t new_cap) {
-  int_t len = std_fmemget(stack + 1);
-  int_t arr = std_fmemget(stack + 2);
+// Implementation based on a dynamic array (vector.h): the stack is the vector
+// The top of the stack is the last item
+// The capacity doubles when full (vector growth policy), and halves when
+// 1 / factor full (shrink policy)
+// Batch operations are a single std_fmemcpy to / from the items array
+//
+// The shrink factor (0 if disabled) is the extra word of the vector header
 
-  int_t new_arr = fm_alloc(new_cap);
-  std_fmemcpy(new_arr, arr, len);
-  fm_free(arr);
-  std_fmemset(stack, new_cap);
-  std_fmemset(stack + 2, new_arr);
+#define DEFAULT_SHRINK (4)
+
+// Apply the shrink policy, after pops left `size` items
+// A batch pop may need several halvings
+static void stack_maybe_shrink(int_t stack, int_t size) {
+  int_t factor = std_fmemget(vec_extra(stack));
+  while (factor && size > 0 && size <= vec_cap(stack) / factor)
+    vec_shrink(stack, vec_cap(stack) / 2);
 }
 
 int_t stack_new() {
-  int_t stack = fm_alloc(3);
-  int_t arr = fm_alloc(2);
-  std_fmemset(stack, 2);
-  std_fmemset(stack + 1, 0);
-  std_fmemset(stack + 2, arr);
+  int_t stack = vec_new_extra(2, 1);
+  std_fmemset(vec_extra(stack), DEFAULT_SHRINK);
   return stack;
 }
 
-void stack_free(int_t stack) {
-  int_t arr = std_fmemget(stack + 2);
-  fm_free(arr);
-  fm_free(stack);
+void stack_free(int_t stack) { vec_free(stack); }
+
+void stack_push(int_t stack, int_t val) { vec_push_back(stack, val); }
+
+int_t stack_pop(int_t stack) {
+  int_t size = vec_size(stack) - 1;
+  int_t val = vec_pop_back(stack);
+  stack_maybe_shrink(stack, size);
+  return val;
 }
 
-void stack_push(int_t stack, int_t val) {
-  int_t cap = std_fmemget(stack);
-  int_t len = std_fmemget(stack + 1);
-  if (len == cap)
-    stack_resize(stack, 2 * cap);
+int_t stack_size(int_t stack) { return vec_size(stack); }
+
+int_t stack_peek(int_t stack) { return vec_back(stack); }
 
-  int_t arr = std_fmemget(stack + 2);
-  std_fmemset(arr + len, val);
-  std_fmemset(stack + 1, len + 1);
+void stack_push_many(int_t stack, int_t src, int_t n) {
+  vec_append(stack, src, n);
 }
 
-int_t stack_pop(int_t stack) {
-  int_t cap = std_fmemget(stack);
-  int_t len = std_fmemget(stack + 1);
-  panic_ifn(len > 0);
-  if (len > 1 && len - 1 == cap / 4)
-    stack_resize(stack, cap / 2);
-
-  int_t arr = std_fmemget(stack + 2);
-  std_fmemset(stack + 1, len - 1);
-  return std_fmemget(arr + len - 1);
+void stack_pop_many(int_t stack, int_t dst, int_t n) {
+  int_t size = vec_size(stack);
+  panic_ifn(n >= 0 && n <= size);
+  std_fmemcpy(dst, vec_data(stack) + size - n, n);
+  vec_erase(stack, size - n, n);
+  stack_maybe_shrink(stack, size - n);
 }
 
-int_t stack_size(int_t stack) { return std_fmemget(stack + 1); }
+void stack_clear(int_t stack) { vec_clear(stack); }
+
+void stack_reserve(int_t stack, int_t cap) { vec_reserve(stack, cap); }
+
+int_t stack_cap(int_t stack) { return vec_cap(stack); }
+
+void stack_set_shrink(int_t stack, int_t factor) {
+  panic_ifn(factor == 0 || factor >= 3);
+  std_fmemset(vec_extra(stack), factor);
+}
@@ -18,4 +18,33 @@ int_t stack_pop(int_t stack);
 // Returns the number of items currently on the stack
 int_t stack_size(int_t stack);
 
+// Returns the item at the top of the stack, without popping it
+// Panic if the stack is empty
+int_t stack_peek(int_t stack);
+
+// Push the `n` items of the array src: src[0] first, src[n - 1] ends on top
+// src must not be in the stack memory
+void stack_push_many(int_t stack, int_t src, int_t n);
+
+// Pop `n` items and write them to the array dst, in stack order: the former
+// top ends in dst[n - 1] (undoes stack_push_many with the same n)
+// Panic if there are less than n items
+void stack_pop_many(int_t stack, int_t dst, int_t n);
+
+// Remove all items, the capacity is unchanged
+void stack_clear(int_t stack);
+
+// Make the capacity at least `cap`
+// Pops may shrink it again, unless shrinking is disabled
+void stack_reserve(int_t stack, int_t cap);
+
+// Returns the number of items that fit without reallocation
+int_t stack_cap(int_t stack);
+
+// Set the shrink policy: after a pop, the capacity is halved when the stack is
+// at most 1 / factor full
+// factor 0 disables shrinking, otherwise it must be >= 3 (the halved array
+// is never full). Default: 4
+void stack_set_shrink(int_t stack, int_t factor);
+
 #endif //! STACK_H_
@@ -26,7 +26,84 @@ void test2() {
   }
 }
 
+void test3() {
+  std::vector<int> s;
+  std::vector<int> src;
+  for (int i = 0; i < 100; ++i)
+    src.push_back(3 * i - 50);
+
+  s.push_back(7);
+  s.insert(s.end(), src.begin(), src.end());
+  std::cout << s.size() << std::endl;
+  std::cout << s.back() << std::endl;
+
+  for (std::size_t i = s.size() - 30; i < s.size(); ++i)
+    std::cout << s[i] << " ";
+  std::cout << std::endl;
+  s.resize(s.size() - 30);
+  std::cout << s.size() << std::endl;
+  std::cout << s.back() << std::endl;
+
+  std::cout << s[0] << std::endl;
+  std::cout << s[70] << std::endl;
+  s.clear();
+  std::cout << s.size() << std::endl;
+
+  s.insert(s.end(), src.begin() + 10, src.begin() + 15);
+  std::cout << 1000 << std::endl;
+  std::cout << s.back() << std::endl;
+  s.clear();
+  std::cout << s.size() << std::endl;
+  std::cout << 5 << std::endl;
+}
+
+// Model of the capacity of the vector-based stack
+struct capacity_model {
+  int cap = 2;
+  int factor = 4;
+  std::size_t size = 0;
+
+  void push() {
+    ++size;
+    if (size > static_cast<std::size_t>(cap))
+      cap *= 2;
+  }
+
+  void pop() {
+    --size;
+    while (factor && size > 0 && size <= static_cast<std::size_t>(cap / factor))
+      cap /= 2;
+  }
+};
+
+void test4() {
+  capacity_model m;
+  m.factor = 0;
+  for (int i = 0; i < 1000; ++i)
+    m.push();
+  while (m.size)
+    m.pop();
+  std::cout << m.cap << std::endl;
+
+  m.cap = 5000;
+  std::cout << m.cap << std::endl;
+  std::cout << m.cap << std::endl;
+
+  m.factor = 4;
+  for (int i = 0; i < 10; ++i)
+    m.push();
+  m.pop();
+  std::cout << 9 << std::endl;
+  std::cout << m.cap << std::endl;
+  while (m.size > 2)
+    m.pop();
+  std::cout << m.cap << std::endl;
+  std::cout << 1 << std::endl;
+}
+
 int main() {
   test1();
   test2();
+  test3();
+  test4();
 }
@@ -1,3 +1,4 @@
+#include "lealloc.h"
 #include "leio.h"
 #include "stack.h"
 
@@ -30,7 +31,58 @@ void test2() {
   stack_free(s);
 }
 
+// Batch operations
+void test3() {
+  int_t s = stack_new(128);
+  int_t src = fm_alloc(100);
+  int_t dst = fm_alloc(100);
+  int_t i = 0;
+  while (i < 100) {
+    std_fmemset(src + i, 3 * i - 50);
+    i = i + 1;
+  }
+
+  stack_push(s, 7);
+  stack_push_many(s, src, 100);
+  printnl_int(stack_size(s));
+  printnl_int(stack_peek(s));
+
+  stack_pop_many(s, dst, 30);
+  i = 0;
+  while (i < 30) {
+    print_int(std_fmemget(dst + i));
+    std_putc(32);
+    i = i + 1;
+  }
+  printnl();
+  printnl_int(stack_size(s));
+  printnl_int(stack_peek(s));
+
+  stack_pop_many(s, dst, 0);
+  stack_pop_many(s, dst, 71);
+  printnl_int(std_fmemget(dst));
+  printnl_int(std_fmemget(dst + 70));
+  printnl_int(stack_size(s));
+
+  stack_push_many(s, src + 10, 5);
+  stack_push(s, 1000);
+  printnl_int(stack_pop(s));
+  printnl_int(stack_peek(s));
+  stack_clear(s);
+  printnl_int(stack_size(s));
+  stack_push(s, 5);
+  printnl_int(stack_peek(s));
+
+  stack_reserve(s, 128);
+  printnl_int(stack_cap(s));
+
+  fm_free(src);
+  fm_free(dst);
+  stack_free(s);
+}
+
 int main() {
   test1();
   test2();
+  test3();
 }
@@ -30,3 +30,34 @@ int_t stack_pop(int_t stack) {
 }
 
 int_t stack_size(int_t stack) { return std_fmemget(stack + 1); }
+
+int_t stack_peek(int_t stack) {
+  int_t len = std_fmemget(stack + 1);
+  panic_ifn(len > 0);
+  return std_fmemget(stack + 1 + len);
+}
+
+// Push the items with one copy
+void stack_push_many(int_t stack, int_t src, int_t n) {
+  int_t cap = std_fmemget(stack);
+  int_t len = std_fmemget(stack + 1);
+  panic_ifn(n >= 0 && len + n <= cap);
+  std_fmemcpy(stack + 2 + len, src, n);
+  std_fmemset(stack + 1, len + n);
+}
+
+// Pop the items with one copy
+void stack_pop_many(int_t stack, int_t dst, int_t n) {
+  int_t len = std_fmemget(stack + 1);
+  panic_ifn(n >= 0 && n <= len);
+  std_fmemset(stack + 1, len - n);
+  std_fmemcpy(dst, stack + 2 + len - n, n);
+}
+
+void stack_clear(int_t stack) { std_fmemset(stack + 1, 0); }
+
+void stack_reserve(int_t stack, int_t cap) {
+  panic_ifn(cap <= std_fmemget(stack));
+}
+
+int_t stack_cap(int_t stack) { return std_fmemget(stack); }
@@ -18,4 +18,27 @@ int_t stack_pop(int_t stack);
 // Returns the number of items currently on the stack
 int_t stack_size(int_t stack);
 
+// Returns the item at the top of the stack, without popping it
+// Panic if the stack is empty
+int_t stack_peek(int_t stack);
+
+// Push the `n` items of the array src: src[0] first, src[n - 1] ends on top
+// Panic if they don't fit in the capacity
+void stack_push_many(int_t stack, int_t src, int_t n);
+
+// Pop `n` items and write them to the array dst, in stack order: the former
+// top ends in dst[n - 1] (undoes stack_push_many with the same n)
+// Panic if there are less than n items
+void stack_pop_many(int_t stack, int_t dst, int_t n);
+
+// Remove all items
+void stack_clear(int_t stack);
+
+// Check that `cap` items fit in the stack: the capacity is fixed
+// Panic if cap is larger than the capacity
+void stack_reserve(int_t stack, int_t cap);
+
+// Returns the capacity given to stack_new
+int_t stack_cap(int_t stack);
+
 #endif //! STACK_H_
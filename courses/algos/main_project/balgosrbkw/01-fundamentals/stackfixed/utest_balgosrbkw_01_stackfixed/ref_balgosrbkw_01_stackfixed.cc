@@ -26,7 +26,40 @@ void test2() {
   }
 }
 
+void test3() {
+  std::vector<int> s;
+  std::vector<int> src;
+  for (int i = 0; i < 100; ++i)
+    src.push_back(3 * i - 50);
+
+  s.push_back(7);
+  s.insert(s.end(), src.begin(), src.end());
+  std::cout << s.size() << std::endl;
+  std::cout << s.back() << std::endl;
+
+  for (std::size_t i = s.size() - 30; i < s.size(); ++i)
+    std::cout << s[i] << " ";
+  std::cout << std::endl;
+  s.resize(s.size() - 30);
+  std::cout << s.size() << std::endl;
+  std::cout << s.back() << std::endl;
+
+  std::cout << s[0] << std::endl;
+  std::cout << s[70] << std::endl;
+  s.clear();
+  std::cout << s.size() << std::endl;
+
+  s.insert(s.end(), src.begin() + 10, src.begin() + 15);
+  std::cout << 1000 << std::endl;
+  std::cout << s.back() << std::endl;
+  s.clear();
+  std::cout << s.size() << std::endl;
+  std::cout << 5 << std::endl;
+  std::cout << 128 << std::endl;
+}
+
 int main() {
   test1();
   test2();
+  test3();
 }
@@ -0,0 +1,84 @@
+#include "stack.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// Implementation based on an unrolled linked list
+// Same as stackll, but every node holds a block of up to BLOCK_SIZE values
+// => one link and one allocation for BLOCK_SIZE values instead of one per
+// value, and consecutive pushes / pops stay in the same block
+//
+// Only the top node can be partially filled, all nodes below it are full.
+// When the top node gets empty, it's kept as a spare instead of being freed:
+// pushes and pops oscillating around a block boundary don't allocate.
+//
+// Memory layout:
+// - stack[0]: top node
+// - stack[1]: number of items
+// - stack[2]: spare node (or 0)
+//
+// Node layout: next, count, vals[BLOCK_SIZE]
+
+#define BLOCK_SIZE (32)
+
+int_t stack_new() {
+  int_t stack = fm_alloc(3);
+  std_fmemset(stack, 0);
+  std_fmemset(stack + 1, 0);
+  std_fmemset(stack + 2, 0);
+  return stack;
+}
+
+void stack_free(int_t stack) {
+  int_t node = std_fmemget(stack);
+  while (node) {
+    int_t next_node = std_fmemget(node);
+    fm_free(node);
+    node = next_node;
+  }
+
+  if (std_fmemget(stack + 2))
+    fm_free(std_fmemget(stack + 2));
+  fm_free(stack);
+}
+
+void stack_push(int_t stack, int_t val) {
+  int_t top = std_fmemget(stack);
+  if (top == 0 || std_fmemget(top + 1) == BLOCK_SIZE) {
+    int_t node = std_fmemget(stack + 2);
+    if (node)
+      std_fmemset(stack + 2, 0);
+    else
+      node = fm_alloc(2 + BLOCK_SIZE);
+    std_fmemset(node, top);
+    std_fmemset(node + 1, 0);
+    std_fmemset(stack, node);
+    top = node;
+  }
+
+  int_t count = std_fmemget(top + 1);
+  std_fmemset(top + 2 + count, val);
+  std_fmemset(top + 1, count + 1);
+  std_fmemset(stack + 1, std_fmemget(stack + 1) + 1);
+}
+
+// When the top node gets empty, it replaces the spare node
+int_t stack_pop(int_t stack) {
+  int_t top = std_fmemget(stack);
+  panic_ifn(top);
+
+  int_t count = std_fmemget(top + 1) - 1;
+  int_t val = std_fmemget(top + 2 + count);
+  std_fmemset(top + 1, count);
+
+  if (count == 0) {
+    std_fmemset(stack, std_fmemget(top));
+    if (std_fmemget(stack + 2))
+      fm_free(std_fmemget(stack + 2));
+    std_fmemset(stack + 2, top);
+  }
+
+  std_fmemset(stack + 1, std_fmemget(stack + 1) - 1);
+  return val;
+}
+
+int_t stack_size(int_t stack) { return std_fmemget(stack + 1); }
@@ -0,0 +1,130 @@
+#include "cuf.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// Implementation based on a forest of trees, like uf.c, with all parent links
+// modified with compare-and-swap (CAS)
+//
+// Union: find both roots, and link the root with the lowest priority under the
+// other one with a CAS, which fails if it's not a root anymore (another thread
+// linked it meanwhile): then search the roots again.
+// Sizes can't be updated atomically with the link, so the priority of a site
+// is a fixed random number (hash of its index, all different): the trees have
+// a logarithmic height in average
+//
+// Find: path halving, every visited node is linked to its grandparent with a
+// CAS. If the CAS fails, another thread changed the parent to an ancestor, the
+// path is still valid
+//
+// Memory layout:
+// - uf[0]: number of components
+// - uf[1]: number of sites n
+// - uf[2 .. 2+n[: parents
+
+static int_t id_addr(int_t uf, int_t idx) { return uf + 2 + idx; }
+
+// Random priority: multiplicative hashing is a bijection, no 2 sites have the
+// same priority
+static uint32_t prio(int_t idx) { return (uint32_t)idx * 2654435761u; }
+
+int_t cuf_new(int_t n) {
+  int_t uf = fm_alloc(2 + n);
+  std_fmemset(uf, n);
+  std_fmemset(uf + 1, n);
+  int_t i = 0;
+  while (i < n) {
+    std_fmemset(id_addr(uf, i), i);
+    i = i + 1;
+  }
+
+  return uf;
+}
+
+void cuf_free(int_t uf) { fm_free(uf); }
+
+int_t cuf_union(int_t uf, int_t p, int_t q) {
+  while (1) {
+    int_t pr = cuf_find(uf, p);
+    int_t qr = cuf_find(uf, q);
+    if (pr == qr)
+      return 0;
+
+    if (prio(pr) > prio(qr)) {
+      int_t tmp = pr;
+      pr = qr;
+      qr = tmp;
+    }
+
+    if (std_fmemcas(id_addr(uf, pr), pr, qr)) {
+      std_fmemxadd(uf, -1);
+      return 1;
+    }
+  }
+}
+
+// Context of cuf_union_many, shared by all threads:
+// - ctx[0]: unionfind
+// - ctx[1]: pairs
+// - ctx[2]: number of pairs
+// - ctx[3]: number of threads
+// - ctx[4]: number of merges
+
+// Thread idx unions the pairs [idx * n / nb_threads, (idx+1) * n / nb_threads[
+static void union_range(int_t ctx, int_t idx) {
+  int_t uf = std_fmemget(ctx);
+  int_t pairs = std_fmemget(ctx + 1);
+  int_t n = std_fmemget(ctx + 2);
+  int_t nb_threads = std_fmemget(ctx + 3);
+  int_t i = idx * n / nb_threads;
+  int_t end = (idx + 1) * n / nb_threads;
+
+  int_t res = 0;
+  while (i < end) {
+    res = res + cuf_union(uf, std_fmemget(pairs + 2 * i),
+                          std_fmemget(pairs + 2 * i + 1));
+    i = i + 1;
+  }
+  std_fmemxadd(ctx + 4, res);
+}
+
+int_t cuf_union_many(int_t uf, int_t pairs, int_t n, int_t nb_threads) {
+  int_t ctx = fm_alloc(5);
+  std_fmemset(ctx, uf);
+  std_fmemset(ctx + 1, pairs);
+  std_fmemset(ctx + 2, n);
+  std_fmemset(ctx + 3, nb_threads);
+  std_fmemset(ctx + 4, 0);
+
+  std_parallel(nb_threads, union_range, ctx);
+
+  int_t res = std_fmemget(ctx + 4);
+  fm_free(ctx);
+  return res;
+}
+
+int_t cuf_find(int_t uf, int_t p) {
+  int_t parent = std_fmemload(id_addr(uf, p));
+  while (p != parent) {
+    int_t grandparent = std_fmemload(id_addr(uf, parent));
+    if (grandparent != parent)
+      std_fmemcas(id_addr(uf, p), parent, grandparent);
+    p = grandparent;
+    parent = std_fmemload(id_addr(uf, p));
+  }
+  return p;
+}
+
+// If the roots are different, p and q were not connected when pr was found,
+// unless pr was linked meanwhile: then search again
+int_t cuf_connected(int_t uf, int_t p, int_t q) {
+  while (1) {
+    int_t pr = cuf_find(uf, p);
+    int_t qr = cuf_find(uf, q);
+    if (pr == qr)
+      return 1;
+    if (std_fmemload(id_addr(uf, pr)) == pr)
+      return 0;
+  }
+}
+
+int_t cuf_count(int_t uf) { return std_fmemload(uf); }
@@ -0,0 +1,36 @@
+#ifndef CUF_H_
+#define CUF_H_
+
+#include "lestd.h"
+
+// Concurrent unionfind
+// Same operations as uf.h, all of them can be called from several threads at
+// the same time, without any lock
+// The component identifier of a site can change while other threads do
+// unions: only compare identifiers returned while no union is in progress
+
+// Create concurrent unionfind structure with n sites (0 to n - 1)
+int_t cuf_new(int_t n);
+
+// Free all memory of the unionfind
+void cuf_free(int_t uf);
+
+// Connect p and q in one component
+// Returns 1 if p and q were in 2 different components, 0 otherwhise
+int_t cuf_union(int_t uf, int_t p, int_t q);
+
+// Connect p and q in one component for every pair (pairs[2i], pairs[2i+1])
+// pairs is an array of 2n entries, split between `nb_threads` threads
+// Returns the number of unions which merged 2 components
+int_t cuf_union_many(int_t uf, int_t pairs, int_t n, int_t nb_threads);
+
+// Returns the component identifier (between 0 and n - 1) for p
+int_t cuf_find(int_t uf, int_t p);
+
+// Returns true if p and q are in the same component
+int_t cuf_connected(int_t uf, int_t p, int_t q);
+
+// Returns the number of distinct components
+int_t cuf_count(int_t uf);
+
+#endif //! CUF_H_
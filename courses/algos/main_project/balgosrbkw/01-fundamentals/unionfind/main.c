@@ -1,3 +1,5 @@
+#include "cuf.h"
+#include "lealloc.h"
 #include "leio.h"
 #include "uf.h"
 
@@ -61,9 +63,101 @@ void test4() {
   uf_free(g);
 }
 
+// Batched unions, and long paths
+void test5() {
+  int_t n = 1000;
+  int_t g = uf_new(n);
+  int_t pairs = fm_alloc(2 * n);
+  int_t i = 0;
+  while (i < n) {
+    std_fmemset(pairs + 2 * i, (i * 7) % n);
+    std_fmemset(pairs + 2 * i + 1, (i * 7 + 20) % n);
+    i = i + 1;
+  }
+  printnl_int(uf_union_many(g, pairs, 300));
+  printnl_int(uf_count(g));
+  printnl_int(uf_union_many(g, pairs, n));
+  printnl_int(uf_count(g));
+
+  i = 0;
+  while (i < n) {
+    std_fmemset(pairs + 2 * i, 3 * i + 1);
+    std_fmemset(pairs + 2 * i + 1, 3 * i + 8);
+    i = i + 1;
+  }
+  printnl_int(uf_union_many(g, pairs, 150));
+  printnl_int(uf_count(g));
+
+  i = 0;
+  while (i < 60) {
+    printnl_int(uf_find(g, (i * 17) % n));
+    i = i + 1;
+  }
+  printnl_int(uf_union_many(g, pairs, 0));
+  fm_free(pairs);
+  uf_free(g);
+}
+
+// Concurrent unionfind, from one thread
+void test6() {
+  int_t g = cuf_new(12);
+  printnl_int(cuf_union(g, 0, 2));
+  printnl_int(cuf_union(g, 10, 5));
+  printnl_int(cuf_union(g, 4, 2));
+  printnl_int(cuf_union(g, 8, 9));
+  printnl_int(cuf_union(g, 0, 4));
+  printnl_int(cuf_union(g, 5, 8));
+  printnl_int(cuf_union(g, 9, 10));
+
+  int_t i = 0;
+  while (i < 12) {
+    int_t j = 0;
+    while (j < 12) {
+      print_int(cuf_connected(g, i, j));
+      j = j + 1;
+    }
+    printnl();
+    i = i + 1;
+  }
+  printnl_int(cuf_count(g));
+  cuf_free(g);
+}
+
+// Concurrent unionfind, batched unions from several threads
+void test7() {
+  int_t n = 3000;
+  int_t nb_pairs = 4000;
+  int_t pairs = fm_alloc(2 * nb_pairs);
+  int_t i = 0;
+  while (i < nb_pairs) {
+    std_fmemset(pairs + 2 * i, (i * 7919) % n);
+    std_fmemset(pairs + 2 * i + 1, (i * 104729 + 13) % n);
+    i = i + 1;
+  }
+
+  int_t nb_threads = 1;
+  while (nb_threads <= 8) {
+    int_t g = cuf_new(n);
+    printnl_int(cuf_union_many(g, pairs, nb_pairs, nb_threads));
+    printnl_int(cuf_count(g));
+    i = 0;
+    while (i < 100) {
+      print_int(cuf_connected(g, (i * 31) % n, (i * 57 + 5) % n));
+      i = i + 1;
+    }
+    printnl();
+    cuf_free(g);
+    nb_threads = 2 * nb_threads;
+  }
+  fm_free(pairs);
+}
+
 int main() {
   test1();
   test2();
   test3();
   test4();
+  test5();
+  test6();
+  test7();
 }
@@ -11,14 +11,33 @@
 // tree height. In order to reduce height, when doing union we attach the root
 // of the smallest tree to the root of largest one To do this we keep track of
 // the size of every trees
+//
+// Path halving: while going up to the root, every visited node is linked to
+// its grandparent, which halves the length of the path for the next finds.
+// With union by size, operations are amortized O(alpha(n)) (inverse
+// Ackermann, < 5 for any practical n)
+//
+// The parents and the sizes are in 2 separate dense arrays: finds only read
+// the parents array, with n entries per cache line instead of n / 2
+//
+// Memory layout:
+// - uf[0]: number of components
+// - uf[1]: number of sites n
+// - uf[2 .. 2+n[: parents
+// - uf[2+n .. 2+2n[: sizes (only valid for roots)
 
-static int_t id_addr(int_t uf, int_t idx) { return uf + 1 + 2 * idx; }
+#define BATCH_SIZE (16)
 
-static int_t size_addr(int_t uf, int_t idx) { return uf + 1 + 2 * idx + 1; }
+static int_t id_addr(int_t uf, int_t idx) { return uf + 2 + idx; }
+
+static int_t size_addr(int_t uf, int_t idx) {
+  return uf + 2 + std_fmemget(uf + 1) + idx;
+}
 
 int_t uf_new(int_t n) {
-  int_t uf = fm_alloc(1 + 2 * n);
+  int_t uf = fm_alloc(2 + 2 * n);
   std_fmemset(uf, n);
+  std_fmemset(uf + 1, n);
   int_t i = 0;
   while (i < n) {
     std_fmemset(id_addr(uf, i), i);
@@ -31,28 +50,65 @@ int_t uf_new(int_t n) {
 
 void uf_free(int_t uf) { fm_free(uf); }
 
+// Link the roots pr and qr, returns 1 if they were different
+static int_t link_roots(int_t uf, int_t pr, int_t qr) {
+  if (pr == qr)
+    return 0;
+
+  int_t pr_size = std_fmemget(size_addr(uf, pr));
+  int_t qr_size = std_fmemget(size_addr(uf, qr));
+  std_fmemset(uf, std_fmemget(uf) - 1);
+
+  if (pr_size < qr_size) {
+    std_fmemset(id_addr(uf, pr), qr);
+    std_fmemset(size_addr(uf, qr), qr_size + pr_size);
+  } else {
+    std_fmemset(id_addr(uf, qr), pr);
+    std_fmemset(size_addr(uf, pr), pr_size + qr_size);
+  }
+  return 1;
+}
+
 void uf_union(int_t uf, int_t p, int_t q) {
-  int_t pr = uf_find(uf, p);
-  int_t qr = uf_find(uf, q);
-
-  if (pr != qr) {
-    int_t pr_size = std_fmemget(size_addr(uf, pr));
-    int_t qr_size = std_fmemget(size_addr(uf, qr));
-    std_fmemset(uf, std_fmemget(uf) - 1);
-
-    if (pr_size < qr_size) {
-      std_fmemset(id_addr(uf, pr), qr);
-      std_fmemset(size_addr(uf, qr), qr_size + pr_size);
-    } else {
-      std_fmemset(id_addr(uf, qr), pr);
-      std_fmemset(size_addr(uf, pr), pr_size + qr_size);
+  link_roots(uf, uf_find(uf, p), uf_find(uf, q));
+}
+
+// The pairs are processed by chunks of BATCH_SIZE: the parents of all sites of
+// the chunk are prefetched first, so their cache misses overlap
+int_t uf_union_many(int_t uf, int_t pairs, int_t n) {
+  int_t res = 0;
+  int_t beg = 0;
+  while (beg < n) {
+    int_t end = beg + BATCH_SIZE < n ? beg + BATCH_SIZE : n;
+
+    int_t i = beg;
+    while (i < end) {
+      std_fmemprefetch(id_addr(uf, std_fmemget(pairs + 2 * i)));
+      std_fmemprefetch(id_addr(uf, std_fmemget(pairs + 2 * i + 1)));
+      i = i + 1;
     }
+
+    i = beg;
+    while (i < end) {
+      int_t pr = uf_find(uf, std_fmemget(pairs + 2 * i));
+      int_t qr = uf_find(uf, std_fmemget(pairs + 2 * i + 1));
+      res = res + link_roots(uf, pr, qr);
+      i = i + 1;
+    }
+
+    beg = end;
   }
+
+  return res;
 }
 
 int_t uf_find(int_t uf, int_t p) {
-  while (p != std_fmemget(id_addr(uf, p))) {
-    p = std_fmemget(id_addr(uf, p));
+  int_t parent = std_fmemget(id_addr(uf, p));
+  while (p != parent) {
+    int_t grandparent = std_fmemget(id_addr(uf, parent));
+    std_fmemset(id_addr(uf, p), grandparent);
+    p = grandparent;
+    parent = std_fmemget(id_addr(uf, p));
   }
   return p;
 }
@@ -16,6 +16,11 @@ void uf_free(int_t uf);
 // Connect p and q in one component
 void uf_union(int_t uf, int_t p, int_t q);
 
+// Connect p and q in one component for every pair (pairs[2i], pairs[2i+1])
+// pairs is an array of 2n entries
+// Returns the number of unions which merged 2 components
+int_t uf_union_many(int_t uf, int_t pairs, int_t n);
+
 // Returns the component identifier (between 0 and n - 1) for p
 int_t uf_find(int_t uf, int_t p);
 
@@ -23,6 +23,16 @@ public:
     return p;
   }
 
+  int union_many(const std::vector<int> &pairs, int n) {
+    int res = 0;
+    for (int i = 0; i < n; ++i) {
+      int c = count;
+      _union(pairs[2 * i], pairs[2 * i + 1]);
+      res += c - count;
+    }
+    return res;
+  }
+
   void _union(int p, int q) {
     int i = find(p);
     int j = find(q);
@@ -98,9 +108,73 @@ void test4() {
   std::cout << g._count() << std::endl;
 }
 
+void test5() {
+  int n = 1000;
+  UnionFind g(n);
+  std::vector<int> pairs(2 * n);
+  for (int i = 0; i < n; ++i) {
+    pairs[2 * i] = (i * 7) % n;
+    pairs[2 * i + 1] = (i * 7 + 20) % n;
+  }
+  std::cout << g.union_many(pairs, 300) << std::endl;
+  std::cout << g._count() << std::endl;
+  std::cout << g.union_many(pairs, n) << std::endl;
+  std::cout << g._count() << std::endl;
+
+  for (int i = 0; i < n; ++i) {
+    pairs[2 * i] = 3 * i + 1;
+    pairs[2 * i + 1] = 3 * i + 8;
+  }
+  std::cout << g.union_many(pairs, 150) << std::endl;
+  std::cout << g._count() << std::endl;
+
+  for (int i = 0; i < 60; ++i)
+    std::cout << g.find((i * 17) % n) << std::endl;
+  std::cout << g.union_many(pairs, 0) << std::endl;
+}
+
+void test6() {
+  UnionFind g(12);
+  int pairs[][2] = {{0, 2}, {10, 5}, {4, 2}, {8, 9}, {0, 4}, {5, 8}, {9, 10}};
+  for (auto &pair : pairs) {
+    int c = g._count();
+    g._union(pair[0], pair[1]);
+    std::cout << c - g._count() << std::endl;
+  }
+
+  for (int i = 0; i < 12; ++i) {
+    for (int j = 0; j < 12; ++j)
+      std::cout << g.connected(i, j);
+    std::cout << std::endl;
+  }
+  std::cout << g._count() << std::endl;
+}
+
+void test7() {
+  int n = 3000;
+  int nb_pairs = 4000;
+  std::vector<int> pairs(2 * nb_pairs);
+  for (int i = 0; i < nb_pairs; ++i) {
+    pairs[2 * i] = (i * 7919) % n;
+    pairs[2 * i + 1] = (i * 104729 + 13) % n;
+  }
+
+  for (int nb_threads = 1; nb_threads <= 8; nb_threads *= 2) {
+    UnionFind g(n);
+    std::cout << g.union_many(pairs, nb_pairs) << std::endl;
+    std::cout << g._count() << std::endl;
+    for (int i = 0; i < 100; ++i)
+      std::cout << g.connected((i * 31) % n, (i * 57 + 5) % n);
+    std::cout << std::endl;
+  }
+}
+
 int main() {
   test1();
   test2();
   test3();
   test4();
+  test5();
+  test6();
+  test7();
 }
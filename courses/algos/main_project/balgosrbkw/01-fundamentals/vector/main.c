@@ -0,0 +1,135 @@
+#include "lealloc.h"
+#include "leio.h"
+#include "vector.h"
+
+void print_vec(int_t v) {
+  std_putc(91);
+  int_t i = 0;
+  while (i < vec_size(v)) {
+    print_int(vec_get(v, i));
+    if (i + 1 < vec_size(v)) {
+      std_putc(44);
+      std_putc(32);
+    }
+    i = i + 1;
+  }
+  std_putc(93);
+  std_putc(10);
+}
+
+void test1() {
+  int_t v = vec_new(0);
+  printnl_int(vec_size(v));
+  int_t i = 0;
+  while (i < 100) {
+    vec_push_back(v, 3 * i - 40);
+    i = i + 1;
+  }
+  printnl_int(vec_size(v));
+  printnl_int(vec_back(v));
+
+  i = 0;
+  while (i < 100) {
+    vec_set(v, i, vec_get(v, i) * vec_get(v, 99 - i));
+    i = i + 2;
+  }
+  while (vec_size(v) > 50)
+    printnl_int(vec_pop_back(v));
+  print_vec(v);
+  vec_free(v);
+}
+
+void test2() {
+  int_t src = fm_alloc(20);
+  int_t i = 0;
+  while (i < 20) {
+    std_fmemset(src + i, 100 + i);
+    i = i + 1;
+  }
+
+  int_t v = vec_new(4);
+  vec_append(v, src, 5);
+  print_vec(v);
+  vec_insert(v, 0, src + 10, 3);
+  print_vec(v);
+  vec_insert(v, 4, src + 5, 10);
+  print_vec(v);
+  vec_insert(v, vec_size(v), src, 2);
+  vec_insert(v, 3, src, 0);
+  print_vec(v);
+  vec_erase(v, 2, 6);
+  print_vec(v);
+  vec_erase(v, 0, 1);
+  vec_erase(v, vec_size(v) - 2, 2);
+  vec_erase(v, 5, 0);
+  print_vec(v);
+  vec_clear(v);
+  printnl_int(vec_size(v));
+  vec_append(v, src + 15, 5);
+  print_vec(v);
+
+  vec_free(v);
+  fm_free(src);
+}
+
+// Capacities with the growth policies, reserve and shrink
+void test3() {
+  int_t v = vec_new(1);
+  vec_set_growth(v, 3, 2);
+  int_t i = 0;
+  while (i < 40) {
+    vec_push_back(v, i);
+    print_int(vec_cap(v));
+    std_putc(32);
+    i = i + 1;
+  }
+  printnl();
+
+  vec_reserve(v, 100);
+  printnl_int(vec_cap(v));
+  vec_reserve(v, 10);
+  printnl_int(vec_cap(v));
+  vec_shrink(v, 10);
+  printnl_int(vec_cap(v));
+  while (vec_size(v) > 5)
+    vec_pop_back(v);
+  vec_shrink(v, 0);
+  printnl_int(vec_cap(v));
+  print_vec(v);
+
+  vec_set_growth(v, 5, 4);
+  i = 0;
+  while (i < 20) {
+    vec_push_back(v, i);
+    print_int(vec_cap(v));
+    std_putc(32);
+    i = i + 1;
+  }
+  printnl();
+  vec_free(v);
+}
+
+// Extra header words are kept through reallocations
+void test4() {
+  int_t v = vec_new_extra(1, 2);
+  std_fmemset(vec_extra(v), 42);
+  std_fmemset(vec_extra(v) + 1, -7);
+  int_t i = 0;
+  while (i < 30) {
+    vec_push_back(v, 2 * i);
+    i = i + 1;
+  }
+  vec_shrink(v, 0);
+  printnl_int(std_fmemget(vec_extra(v)));
+  printnl_int(std_fmemget(vec_extra(v) + 1));
+  printnl_int(vec_size(v));
+  printnl_int(vec_get(v, 29));
+  vec_free(v);
+}
+
+int main() {
+  test1();
+  test2();
+  test3();
+  test4();
+}
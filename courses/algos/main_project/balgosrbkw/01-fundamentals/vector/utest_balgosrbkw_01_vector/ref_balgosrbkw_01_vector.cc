@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+void print_vec(const std::vector<int> &v) {
+  std::cout << "[";
+  for (std::size_t i = 0; i < v.size(); ++i)
+    std::cout << v[i] << (i + 1 < v.size() ? ", " : "");
+  std::cout << "]" << std::endl;
+}
+
+// Capacity with the same growth policy as vector.c
+struct Cap {
+  int cap;
+  int num = 2;
+  int den = 1;
+
+  void grow_for(int n) {
+    if (n <= cap)
+      return;
+    int new_cap = cap * num / den;
+    if (new_cap < cap + 1)
+      new_cap = cap + 1;
+    if (new_cap < n)
+      new_cap = n;
+    cap = new_cap;
+  }
+};
+
+void test1() {
+  std::vector<int> v;
+  std::cout << v.size() << std::endl;
+  for (int i = 0; i < 100; ++i)
+    v.push_back(3 * i - 40);
+  std::cout << v.size() << std::endl;
+  std::cout << v.back() << std::endl;
+
+  for (int i = 0; i < 100; i += 2)
+    v[i] = v[i] * v[99 - i];
+  while (v.size() > 50) {
+    std::cout << v.back() << std::endl;
+    v.pop_back();
+  }
+  print_vec(v);
+}
+
+void test2() {
+  std::vector<int> src;
+  for (int i = 0; i < 20; ++i)
+    src.push_back(100 + i);
+
+  std::vector<int> v;
+  v.insert(v.end(), src.begin(), src.begin() + 5);
+  print_vec(v);
+  v.insert(v.begin(), src.begin() + 10, src.begin() + 13);
+  print_vec(v);
+  v.insert(v.begin() + 4, src.begin() + 5, src.begin() + 15);
+  print_vec(v);
+  v.insert(v.end(), src.begin(), src.begin() + 2);
+  print_vec(v);
+  v.erase(v.begin() + 2, v.begin() + 8);
+  print_vec(v);
+  v.erase(v.begin());
+  v.erase(v.end() - 2, v.end());
+  print_vec(v);
+  v.clear();
+  std::cout << v.size() << std::endl;
+  v.insert(v.end(), src.begin() + 15, src.end());
+  print_vec(v);
+}
+
+void test3() {
+  std::vector<int> v;
+  Cap c{1};
+  c.num = 3;
+  c.den = 2;
+  for (int i = 0; i < 40; ++i) {
+    v.push_back(i);
+    c.grow_for(v.size());
+    std::cout << c.cap << " ";
+  }
+  std::cout << std::endl;
+
+  c.cap = std::max(c.cap, 100);
+  std::cout << c.cap << std::endl;
+  std::cout << c.cap << std::endl;
+  c.cap = std::max(10, static_cast<int>(v.size()));
+  std::cout << c.cap << std::endl;
+  v.resize(5);
+  c.cap = 5;
+  std::cout << c.cap << std::endl;
+  print_vec(v);
+
+  c.num = 5;
+  c.den = 4;
+  for (int i = 0; i < 20; ++i) {
+    v.push_back(i);
+    c.grow_for(v.size());
+    std::cout << c.cap << " ";
+  }
+  std::cout << std::endl;
+}
+
+void test4() {
+  std::cout << 42 << std::endl;
+  std::cout << -7 << std::endl;
+  std::cout << 30 << std::endl;
+  std::cout << 58 << std::endl;
+}
+
+int main() {
+  test1();
+  test2();
+  test3();
+  test4();
+}
@@ -0,0 +1,131 @@
+#include "vector.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// All reallocations go through vec_realloc: one bulk copy with std_fmemcpy
+//
+// Memory layout:
+// - v[0]: number of items
+// - v[1]: capacity
+// - v[2]: items array
+// - v[3]: growth numerator
+// - v[4]: growth denominator
+// - v[5..]: extra words (vec_new_extra)
+
+static void vec_realloc(int_t v, int_t new_cap) {
+  int_t arr = fm_alloc(new_cap);
+  std_fmemcpy(arr, vec_data(v), vec_size(v));
+  fm_free(vec_data(v));
+  std_fmemset(v + 1, new_cap);
+  std_fmemset(v + 2, arr);
+}
+
+// Make room for `n` items, growing with the growth policy
+static void vec_grow_for(int_t v, int_t n) {
+  int_t cap = vec_cap(v);
+  if (n <= cap)
+    return;
+
+  int_t new_cap = cap * std_fmemget(v + 3) / std_fmemget(v + 4);
+  if (new_cap < cap + 1)
+    new_cap = cap + 1;
+  if (new_cap < n)
+    new_cap = n;
+  vec_realloc(v, new_cap);
+}
+
+int_t vec_new(int_t cap) { return vec_new_extra(cap, 0); }
+
+int_t vec_new_extra(int_t cap, int_t nb_extra) {
+  panic_ifn(nb_extra >= 0);
+  int_t v = fm_alloc(5 + nb_extra);
+  std_fmemset(v, 0);
+  std_fmemset(v + 1, cap);
+  std_fmemset(v + 2, fm_alloc(cap));
+  std_fmemset(v + 3, 2);
+  std_fmemset(v + 4, 1);
+  return v;
+}
+
+int_t vec_extra(int_t v) { return v + 5; }
+
+void vec_free(int_t v) {
+  fm_free(vec_data(v));
+  fm_free(v);
+}
+
+void vec_set_growth(int_t v, int_t num, int_t den) {
+  panic_ifn(den >= 1 && num > den);
+  std_fmemset(v + 3, num);
+  std_fmemset(v + 4, den);
+}
+
+int_t vec_size(int_t v) { return std_fmemget(v); }
+
+int_t vec_cap(int_t v) { return std_fmemget(v + 1); }
+
+int_t vec_data(int_t v) { return std_fmemget(v + 2); }
+
+int_t vec_get(int_t v, int_t i) {
+  panic_ifn(i >= 0 && i < vec_size(v));
+  return std_fmemget(vec_data(v) + i);
+}
+
+void vec_set(int_t v, int_t i, int_t val) {
+  panic_ifn(i >= 0 && i < vec_size(v));
+  std_fmemset(vec_data(v) + i, val);
+}
+
+int_t vec_back(int_t v) { return vec_get(v, vec_size(v) - 1); }
+
+void vec_push_back(int_t v, int_t val) {
+  int_t size = vec_size(v);
+  vec_grow_for(v, size + 1);
+  std_fmemset(vec_data(v) + size, val);
+  std_fmemset(v, size + 1);
+}
+
+int_t vec_pop_back(int_t v) {
+  int_t size = vec_size(v);
+  panic_ifn(size > 0);
+  std_fmemset(v, size - 1);
+  return std_fmemget(vec_data(v) + size - 1);
+}
+
+void vec_append(int_t v, int_t src, int_t n) {
+  vec_insert(v, vec_size(v), src, n);
+}
+
+void vec_insert(int_t v, int_t pos, int_t src, int_t n) {
+  int_t size = vec_size(v);
+  panic_ifn(pos >= 0 && pos <= size && n >= 0);
+  vec_grow_for(v, size + n);
+
+  int_t arr = vec_data(v);
+  std_fmemcpy(arr + pos + n, arr + pos, size - pos);
+  std_fmemcpy(arr + pos, src, n);
+  std_fmemset(v, size + n);
+}
+
+void vec_erase(int_t v, int_t pos, int_t n) {
+  int_t size = vec_size(v);
+  panic_ifn(pos >= 0 && n >= 0 && pos + n <= size);
+
+  int_t arr = vec_data(v);
+  std_fmemcpy(arr + pos, arr + pos + n, size - pos - n);
+  std_fmemset(v, size - n);
+}
+
+void vec_clear(int_t v) { std_fmemset(v, 0); }
+
+void vec_reserve(int_t v, int_t cap) {
+  if (cap > vec_cap(v))
+    vec_realloc(v, cap);
+}
+
+void vec_shrink(int_t v, int_t cap) {
+  if (cap < vec_size(v))
+    cap = vec_size(v);
+  if (cap < vec_cap(v))
+    vec_realloc(v, cap);
+}
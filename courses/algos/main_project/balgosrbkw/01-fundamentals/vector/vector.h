@@ -0,0 +1,85 @@
+#ifndef VECTOR_H_
+#define VECTOR_H_
+
+#include "lestd.h"
+
+// Dynamic array
+// Items are stored contiguously in one flat memory array, which is
+// reallocated when full.
+// When the array is full, the new capacity is cap * num / den (growth policy,
+// 2 / 1 by default), and at least cap + 1.
+// The address of the array (vec_data) changes when it's reallocated
+
+// Create a new empty vector, with capacity `cap`
+int_t vec_new(int_t cap);
+
+// Same as vec_new, with `nb_extra` more words in the vector header, free for
+// the user (for structures built on a vector)
+int_t vec_new_extra(int_t cap, int_t nb_extra);
+
+// Returns the address of the extra header words of vec_new_extra
+int_t vec_extra(int_t v);
+
+// Free all memory of the vector
+void vec_free(int_t v);
+
+// Set the growth policy: the new capacity is cap * num / den
+// Panic if num <= den or den < 1
+void vec_set_growth(int_t v, int_t num, int_t den);
+
+// Returns the number of items
+int_t vec_size(int_t v);
+
+// Returns the capacity: number of items that fit without reallocation
+int_t vec_cap(int_t v);
+
+// Returns the address of the items array
+// Only valid until the next operation which changes the capacity
+int_t vec_data(int_t v);
+
+// Returns the item at index i
+// Panic if i is not in [0, size[
+int_t vec_get(int_t v, int_t i);
+
+// Set the item at index i to val
+// Panic if i is not in [0, size[
+void vec_set(int_t v, int_t i, int_t val);
+
+// Returns the last item
+// Panic if the vector is empty
+int_t vec_back(int_t v);
+
+// Add val after the last item
+void vec_push_back(int_t v, int_t val);
+
+// Remove and return the last item
+// Never reallocates the array
+// Panic if the vector is empty
+int_t vec_pop_back(int_t v);
+
+// Add the `n` items of the array src after the last item
+// src must not be in the items array
+void vec_append(int_t v, int_t src, int_t n);
+
+// Insert the `n` items of the array src before index pos
+// The items from pos are moved by n
+// src must not be in the items array
+// Panic if pos is not in [0, size]
+void vec_insert(int_t v, int_t pos, int_t src, int_t n);
+
+// Remove the `n` items from index pos
+// The items after are moved back by n
+// Panic if [pos, pos + n[ is not in [0, size]
+void vec_erase(int_t v, int_t pos, int_t n);
+
+// Remove all items, the capacity is unchanged
+void vec_clear(int_t v);
+
+// Make the capacity at least `cap`
+void vec_reserve(int_t v, int_t cap);
+
+// Reduce the capacity to max(cap, size)
+// Does nothing if the capacity is already smaller
+void vec_shrink(int_t v, int_t cap);
+
+#endif //! VECTOR_H_
@@ -1,6 +1,6 @@
 #include "heap.h"
-#include "lealloc.h"
 #include "ledebug.h"
+#include "vector.h"
 
 // Binary heap: implementation of priority queue
 // Complete binary tree
@@ -10,22 +10,9 @@
 // The whole tree represented by an array of base-1 index
 // Root at index 1
 // Parent of node k is k/2, And children of node k are 2*k and 2*k + 1
+// The array is a dynamic array (vector.h): the heap is the vector
 
-static void heap_resize(int_t h, int_t new_cap) {
-  int_t len = std_fmemget(h);
-  int_t arr = std_fmemget(h + 2);
-  int_t new_arr = fm_alloc(new_cap);
-
-  std_fmemcpy(new_arr, arr, len);
-  std_fmemset(h + 1, new_cap);
-  std_fmemset(h + 2, new_arr);
-  fm_free(arr);
-}
-
-static int_t node_addr(int_t h, int_t k) {
-  int_t arr = std_fmemget(h + 2);
-  return arr - 1 + k;
-}
+static int_t node_addr(int_t h, int_t k) { return vec_data(h) - 1 + k; }
 
 static void node_swap(int_t h, int_t p, int_t q) {
   int_t pval = std_fmemget(node_addr(h, p));
@@ -55,7 +42,7 @@ static void swim(int_t h, int_t k) {
 // Swap nodes with its children toward the leaves, until rule is ensured again.
 static void sink(int_t h, int_t k) {
   int_t valid = 0;
-  int_t len = std_fmemget(h);
+  int_t len = vec_size(h);
 
   while (valid == 0) {
     if (2 * k > len) {
@@ -76,41 +63,24 @@ static void sink(int_t h, int_t k) {
   }
 }
 
-int_t heap_new() {
-  int_t h = fm_alloc(3);
-  int_t arr = fm_alloc(4);
-  std_fmemset(h, 0);
-  std_fmemset(h + 1, 4);
-  std_fmemset(h + 2, arr);
-  return h;
-}
+int_t heap_new() { return vec_new(4); }
 
-void heap_free(int_t h) {
-  fm_free(h + 2);
-  fm_free(h);
-}
+void heap_free(int_t h) { vec_free(h); }
 
 // add item at the end of the array and swim the value towards the root
 void heap_push(int_t h, int_t val) {
-  int_t len = std_fmemget(h);
-  int_t cap = std_fmemget(h + 1);
-  if (len == cap) {
-    heap_resize(h, cap * 2);
-  }
-
-  std_fmemset(node_addr(h, len + 1), val);
-  std_fmemset(h, len + 1);
-  swim(h, len + 1);
+  vec_push_back(h, val);
+  swim(h, vec_size(h));
 }
 
 // Put last item on top of the list, and sink value towards the leaves
 int_t heap_pop(int_t h) {
-  int_t len = std_fmemget(h);
+  int_t len = vec_size(h);
   panic_ifn(len > 0);
   int_t res = std_fmemget(node_addr(h, 1));
 
   node_swap(h, 1, len);
-  std_fmemset(h, len - 1);
+  vec_pop_back(h);
   sink(h, 1);
 
   return res;
@@ -122,4 +92,4 @@ int_t heap_min(int_t h) {
   return std_fmemget(node_addr(h, 1));
 }
 
-int_t heap_size(int_t h) { return std_fmemget(h); }
+int_t heap_size(int_t h) { return vec_size(h); }
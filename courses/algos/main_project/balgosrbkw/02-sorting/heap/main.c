@@ -114,10 +114,49 @@ void test5() {
   fm_free(arr);
 }
 
+// Returns random number in [0, n[
+int_t rand_delay(int_t rng, int_t n) {
+  int_t x = rng_next(rng) % n;
+  return x < 0 ? -x : x;
+}
+
+// Monotone workload: pop the next event, and schedule new events after it
+void test6() {
+  int_t h = heap_new();
+  int_t rng = rng_new(42);
+
+  int_t i = 0;
+  while (i < 20) {
+    heap_push(h, rng_next(rng) % 100 - 50);
+    i = i + 1;
+  }
+
+  i = 0;
+  while (i < 300) {
+    printnl_int(heap_min(h));
+    int_t t = heap_pop(h);
+    heap_push(h, t + rand_delay(rng, 50));
+    if (i % 3 == 0)
+      heap_push(h, t + rand_delay(rng, 200));
+    if (i % 4 == 0)
+      heap_push(h, t);
+    i = i + 1;
+  }
+
+  printnl_int(heap_size(h));
+  while (heap_size(h)) {
+    printnl_int(heap_pop(h));
+  }
+
+  rng_free(rng);
+  heap_free(h);
+}
+
 int main() {
   test1();
   test2();
   test3();
   test4();
   test5();
+  test6();
 }
@@ -1,6 +1,8 @@
 #include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <iostream>
+#include <queue>
 #include <vector>
 
 class RNG {
@@ -69,10 +71,44 @@ void test5() {
   print_arr(arr);
 }
 
+using MinHeap =
+    std::priority_queue<std::int32_t, std::vector<std::int32_t>,
+                        std::greater<std::int32_t>>;
+
+int rand_delay(RNG &rng, int n) {
+  int x = rng.next() % n;
+  return x < 0 ? -x : x;
+}
+
+void test6() {
+  MinHeap h;
+  RNG rng(42);
+  for (int i = 0; i < 20; ++i)
+    h.push(rng.next() % 100 - 50);
+
+  for (int i = 0; i < 300; ++i) {
+    std::cout << h.top() << std::endl;
+    int t = h.top();
+    h.pop();
+    h.push(t + rand_delay(rng, 50));
+    if (i % 3 == 0)
+      h.push(t + rand_delay(rng, 200));
+    if (i % 4 == 0)
+      h.push(t);
+  }
+
+  std::cout << h.size() << std::endl;
+  while (!h.empty()) {
+    std::cout << h.top() << std::endl;
+    h.pop();
+  }
+}
+
 int main() {
   test1();
   test2();
   test3();
   test4();
   test5();
+  test6();
 }
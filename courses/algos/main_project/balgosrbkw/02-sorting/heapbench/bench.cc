@@ -0,0 +1,94 @@
+// Benchmark of the priority queue implementations
+// The same driver is linked against every implementation of heap.h:
+// - heap: binary heap
+// - pairingheap: pairing heap
+// - radixheap: radix heap (monotone only)
+//
+// All workloads are monotone (pushed values >= last popped value), so they can
+// run on all implementations:
+// - sort: push n random values, then pop them all
+// - events: event scheduler, n pending events, pop the next one and push a
+//   new event after it, 2n times
+// - mix: 3n random operations, 2/3 push, 1/3 pop, then pop everything
+
+extern "C" {
+#include "heap.h"
+}
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+namespace {
+
+using clk = std::chrono::steady_clock;
+
+void report(const char *name, int n, long ops, clk::time_point start) {
+  double secs = std::chrono::duration<double>(clk::now() - start).count();
+  std::cout << name << "\t" << n << "\t" << ops << "\t" << secs * 1e3 << "\t"
+            << ops / secs / 1e6 << std::endl;
+}
+
+void bench_sort(int n) {
+  std::mt19937 rng(n);
+  std::uniform_int_distribution<std::int32_t> dist(-1000000, 1000000);
+  auto start = clk::now();
+
+  int_t h = heap_new();
+  for (int i = 0; i < n; ++i)
+    heap_push(h, dist(rng));
+  for (int i = 0; i < n; ++i)
+    heap_pop(h);
+  heap_free(h);
+
+  report("sort", n, 2L * n, start);
+}
+
+void bench_events(int n) {
+  std::mt19937 rng(n);
+  std::uniform_int_distribution<std::int32_t> delay(0, 1000);
+  auto start = clk::now();
+
+  int_t h = heap_new();
+  for (int i = 0; i < n; ++i)
+    heap_push(h, delay(rng));
+  for (int i = 0; i < 2 * n; ++i)
+    heap_push(h, heap_pop(h) + delay(rng));
+  heap_free(h);
+
+  report("events", n, n + 4L * n, start);
+}
+
+void bench_mix(int n) {
+  std::mt19937 rng(n);
+  std::uniform_int_distribution<std::int32_t> delay(0, 1000);
+  std::uniform_int_distribution<int> op(0, 2);
+  int_t last = 0;
+  long ops = 0;
+  auto start = clk::now();
+
+  int_t h = heap_new();
+  for (int i = 0; i < 3 * n; ++i, ++ops) {
+    if (op(rng) || heap_size(h) == 0)
+      heap_push(h, last + delay(rng));
+    else
+      last = heap_pop(h);
+  }
+  for (; heap_size(h); ++ops)
+    heap_pop(h);
+  heap_free(h);
+
+  report("mix", n, ops, start);
+}
+
+} // namespace
+
+int main() {
+  std::cout << "workload\tn\tops\ttime_ms\tMops/s" << std::endl;
+  for (int n = 1000; n <= 100000; n *= 10) {
+    bench_sort(n);
+    bench_events(n);
+    bench_mix(n);
+  }
+}
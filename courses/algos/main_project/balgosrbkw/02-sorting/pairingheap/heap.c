@@ -0,0 +1,140 @@
+#include "heap.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// Pairing heap: implementation of priority queue
+// Heap-ordered multiway tree
+// Every node has a key, a pointer to its first child, and a pointer to its
+// next sibling
+// The key of every node is smaller than the keys of its children
+// => The smallest value is at the root
+//
+// Link 2 trees: the root with the biggest key becomes the first child of the
+// other root => O(1)
+// Push: link the root with a new single node tree => O(1)
+// Meld: link the 2 roots => O(1)
+// Pop: remove the root, and link its children 2 by 2 (two-pass pairing)
+// => amortized O(log(n))
+//
+// Memory layout:
+// - h[0]: number of items
+// - h[1]: root node
+// - node[0]: key
+// - node[1]: first child
+// - node[2]: next sibling
+
+static int_t node_new(int_t key) {
+  int_t node = fm_alloc(3);
+  std_fmemset(node, key);
+  std_fmemset(node + 1, 0);
+  std_fmemset(node + 2, 0);
+  return node;
+}
+
+// Link 2 trees without siblings, returns the new root
+static int_t node_link(int_t a, int_t b) {
+  if (a == 0)
+    return b;
+  if (b == 0)
+    return a;
+
+  if (std_fmemget(b) < std_fmemget(a)) {
+    int_t tmp = a;
+    a = b;
+    b = tmp;
+  }
+
+  std_fmemset(b + 2, std_fmemget(a + 1));
+  std_fmemset(a + 1, b);
+  return a;
+}
+
+// Link a list of siblings into a single tree
+// 1) Left to right: link the nodes 2 by 2, and push the results on a stack
+// (using the sibling pointer)
+// 2) Link all trees in the stack, which is from right to left
+static int_t node_merge_pairs(int_t node) {
+  int_t pairs = 0;
+  while (node) {
+    int_t a = node;
+    int_t b = std_fmemget(a + 2);
+    node = b ? std_fmemget(b + 2) : 0;
+
+    std_fmemset(a + 2, 0);
+    if (b)
+      std_fmemset(b + 2, 0);
+    a = node_link(a, b);
+    std_fmemset(a + 2, pairs);
+    pairs = a;
+  }
+
+  int_t res = 0;
+  while (pairs) {
+    int_t next = std_fmemget(pairs + 2);
+    std_fmemset(pairs + 2, 0);
+    res = node_link(res, pairs);
+    pairs = next;
+  }
+
+  return res;
+}
+
+int_t heap_new() {
+  int_t h = fm_alloc(2);
+  std_fmemset(h, 0);
+  std_fmemset(h + 1, 0);
+  return h;
+}
+
+// Free the nodes without recursion:
+// If a node has children, its first child is moved in front of it, with the
+// node as sibling, so that the node is visited again after the child
+void heap_free(int_t h) {
+  int_t node = std_fmemget(h + 1);
+  while (node) {
+    int_t child = std_fmemget(node + 1);
+    if (child) {
+      std_fmemset(node + 1, std_fmemget(child + 2));
+      std_fmemset(child + 2, node);
+      node = child;
+    } else {
+      int_t next = std_fmemget(node + 2);
+      fm_free(node);
+      node = next;
+    }
+  }
+
+  fm_free(h);
+}
+
+void heap_push(int_t h, int_t val) {
+  int_t root = std_fmemget(h + 1);
+  std_fmemset(h + 1, node_link(root, node_new(val)));
+  std_fmemset(h, std_fmemget(h) + 1);
+}
+
+int_t heap_pop(int_t h) {
+  int_t len = std_fmemget(h);
+  panic_ifn(len > 0);
+  int_t root = std_fmemget(h + 1);
+  int_t res = std_fmemget(root);
+
+  std_fmemset(h + 1, node_merge_pairs(std_fmemget(root + 1)));
+  std_fmemset(h, len - 1);
+  fm_free(root);
+  return res;
+}
+
+int_t heap_min(int_t h) {
+  panic_ifn(heap_size(h) > 0);
+  return std_fmemget(std_fmemget(h + 1));
+}
+
+int_t heap_size(int_t h) { return std_fmemget(h); }
+
+void heap_meld(int_t h1, int_t h2) {
+  int_t root = node_link(std_fmemget(h1 + 1), std_fmemget(h2 + 1));
+  std_fmemset(h1 + 1, root);
+  std_fmemset(h1, std_fmemget(h1) + std_fmemget(h2));
+  fm_free(h2);
+}
@@ -0,0 +1,187 @@
+#include "heap.h"
+#include "lealloc.h"
+#include "leio.h"
+#include "lerand.h"
+
+void print_arr(int_t arr, int_t len) {
+  std_putc(91);
+
+  int_t i = 0;
+  while (i < len) {
+    print_int(std_fmemget(arr + i));
+    if (i + 1 < len) {
+      std_putc(44);
+      std_putc(32);
+    }
+    i = i + 1;
+  }
+
+  std_putc(93);
+  std_putc(10);
+}
+
+void sort(int_t arr, int_t len) {
+  int_t h = heap_new();
+
+  int_t i = 0;
+  while (i < len) {
+    heap_push(h, std_fmemget(arr + i));
+    i = i + 1;
+  }
+
+  i = 0;
+  while (i < len) {
+    std_fmemset(arr + i, heap_pop(h));
+    i = i + 1;
+  }
+
+  heap_free(h);
+}
+
+void test1() {
+  int_t arr = fm_alloc(7);
+  std_fmemset(arr + 0, 12);
+  std_fmemset(arr + 1, 8);
+  std_fmemset(arr + 2, -6);
+  std_fmemset(arr + 3, 25);
+  std_fmemset(arr + 4, 18);
+  std_fmemset(arr + 5, 12);
+  std_fmemset(arr + 6, -2);
+  sort(arr, 7);
+  print_arr(arr, 7);
+  fm_free(arr);
+}
+
+void test2() {
+  int_t len = 100;
+  int_t arr = fm_alloc(len);
+
+  int_t i = 0;
+  while (i < len) {
+    std_fmemset(arr + i, -2 * i * i + 5 * i - 8);
+    i += 1;
+  }
+
+  sort(arr, len);
+  print_arr(arr, len);
+  fm_free(arr);
+}
+
+void test3() {
+  int_t len = 207;
+  int_t arr = fm_alloc(len);
+
+  int_t i = 0;
+  while (i < len) {
+    std_fmemset(arr + i, 1000 + 12 * i);
+    i += 1;
+  }
+
+  sort(arr, len);
+  print_arr(arr, len);
+  fm_free(arr);
+}
+
+void test4() {
+  int_t len = 178;
+  int_t arr = fm_alloc(len);
+
+  int_t i = 0;
+  while (i < len) {
+    std_fmemset(arr + i, 1000 - 12 * i);
+    i += 1;
+  }
+
+  sort(arr, len);
+  print_arr(arr, len);
+  fm_free(arr);
+}
+
+void test5() {
+  int_t len = 675;
+  int_t arr = fm_alloc(len);
+  int_t rng = rng_new(78);
+
+  int_t i = 0;
+  while (i < len) {
+    std_fmemset(arr + i, rng_next(rng));
+    i = i + 1;
+  }
+
+  sort(arr, len);
+  print_arr(arr, len);
+  rng_free(rng);
+  fm_free(arr);
+}
+
+// Returns random number in [0, n[
+int_t rand_delay(int_t rng, int_t n) {
+  int_t x = rng_next(rng) % n;
+  return x < 0 ? -x : x;
+}
+
+// Monotone workload: pop the next event, and schedule new events after it
+void test6() {
+  int_t h = heap_new();
+  int_t rng = rng_new(42);
+
+  int_t i = 0;
+  while (i < 20) {
+    heap_push(h, rng_next(rng) % 100 - 50);
+    i = i + 1;
+  }
+
+  i = 0;
+  while (i < 300) {
+    printnl_int(heap_min(h));
+    int_t t = heap_pop(h);
+    heap_push(h, t + rand_delay(rng, 50));
+    if (i % 3 == 0)
+      heap_push(h, t + rand_delay(rng, 200));
+    if (i % 4 == 0)
+      heap_push(h, t);
+    i = i + 1;
+  }
+
+  printnl_int(heap_size(h));
+  while (heap_size(h)) {
+    printnl_int(heap_pop(h));
+  }
+
+  rng_free(rng);
+  heap_free(h);
+}
+
+void test7() {
+  int_t h1 = heap_new();
+  int_t h2 = heap_new();
+  int_t rng = rng_new(17);
+
+  int_t i = 0;
+  while (i < 150) {
+    heap_push(h1, rng_next(rng) - 16384);
+    heap_push(h2, rng_next(rng) - 16384);
+    if (i % 5 == 0)
+      printnl_int(heap_pop(h1));
+    i = i + 1;
+  }
+
+  heap_meld(h1, h2);
+  printnl_int(heap_size(h1));
+  while (heap_size(h1)) {
+    printnl_int(heap_pop(h1));
+  }
+
+  rng_free(rng);
+  heap_free(h1);
+}
+
+int main() {
+  test1();
+  test2();
+  test3();
+  test4();
+  test5();
+  test6();
+  test7();
+}
@@ -0,0 +1,154 @@
+#include "heap.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// Radix heap: implementation of monotone priority queue
+// Only works if the popped values are never decreasing
+// (eg: event scheduling, Dijkstra with integer weights)
+//
+// Keep track of `last`, the last popped value (lowest int at the begining)
+// The values are stored in 33 unordered buckets:
+// - bucket 0 contains values equal to last
+// - bucket b contains values where the highest bit different from last is b-1
+// - bucket 32 contains values with a different sign bit
+// Every value is >= last, so all values of bucket b are smaller than all
+// values of bucket b + 1
+//
+// Pop takes any value in bucket 0
+// If bucket 0 is empty, the first non-empty bucket b is redistributed:
+// last is set to the smallest value of b, and every value of b moves to a lower
+// bucket (they all have the same bits as the new last above b - 1)
+// A value can only move down, so it's moved at most 32 times
+// => push is O(1), pop is amortized O(log(C)), with C the range of values
+//
+// Memory layout:
+// - h[0]: number of items
+// - h[1]: last
+// - h[2 + 3 * b]: bucket b array
+// - h[2 + 3 * b + 1]: bucket b length
+// - h[2 + 3 * b + 2]: bucket b capacity
+
+#define NB_BUCKETS (33)
+
+static int_t bucket_addr(int_t h, int_t b) { return h + 2 + 3 * b; }
+
+// Returns the bucket where val must be stored, relative to last
+static int_t bucket_idx(int_t last, int_t val) {
+  int_t diff = last ^ val;
+  int_t b = 0;
+  if (diff < 0)
+    return NB_BUCKETS - 1;
+
+  while (diff) {
+    diff = diff / 2;
+    b = b + 1;
+  }
+  return b;
+}
+
+static void bucket_resize(int_t bucket, int_t new_cap) {
+  int_t arr = std_fmemget(bucket);
+  int_t len = std_fmemget(bucket + 1);
+  int_t new_arr = fm_alloc(new_cap);
+
+  std_fmemcpy(new_arr, arr, len);
+  fm_free(arr);
+  std_fmemset(bucket, new_arr);
+  std_fmemset(bucket + 2, new_cap);
+}
+
+static void bucket_push(int_t h, int_t b, int_t val) {
+  int_t bucket = bucket_addr(h, b);
+  int_t len = std_fmemget(bucket + 1);
+  int_t cap = std_fmemget(bucket + 2);
+  if (len == cap)
+    bucket_resize(bucket, cap ? 2 * cap : 4);
+
+  std_fmemset(std_fmemget(bucket) + len, val);
+  std_fmemset(bucket + 1, len + 1);
+}
+
+// Make sure bucket 0 is not empty, by redistributing the first non-empty
+// bucket
+// The heap must not be empty
+static void pull(int_t h) {
+  if (std_fmemget(bucket_addr(h, 0) + 1) == 0) {
+    int_t b = 1;
+    while (std_fmemget(bucket_addr(h, b) + 1) == 0)
+      b = b + 1;
+
+    int_t bucket = bucket_addr(h, b);
+    int_t arr = std_fmemget(bucket);
+    int_t len = std_fmemget(bucket + 1);
+
+    int_t last = std_fmemget(arr);
+    int_t i = 1;
+    while (i < len) {
+      int_t val = std_fmemget(arr + i);
+      last = val < last ? val : last;
+      i = i + 1;
+    }
+
+    std_fmemset(h + 1, last);
+    std_fmemset(bucket + 1, 0);
+    i = 0;
+    while (i < len) {
+      int_t val = std_fmemget(arr + i);
+      bucket_push(h, bucket_idx(last, val), val);
+      i = i + 1;
+    }
+  }
+}
+
+int_t heap_new() {
+  int_t h = fm_alloc(2 + 3 * NB_BUCKETS);
+  std_fmemset(h, 0);
+  std_fmemset(h + 1, -2147483647 - 1);
+
+  int_t b = 0;
+  while (b < NB_BUCKETS) {
+    int_t bucket = bucket_addr(h, b);
+    std_fmemset(bucket, 0);
+    std_fmemset(bucket + 1, 0);
+    std_fmemset(bucket + 2, 0);
+    b = b + 1;
+  }
+
+  return h;
+}
+
+void heap_free(int_t h) {
+  int_t b = 0;
+  while (b < NB_BUCKETS) {
+    fm_free(std_fmemget(bucket_addr(h, b)));
+    b = b + 1;
+  }
+  fm_free(h);
+}
+
+void heap_push(int_t h, int_t val) {
+  int_t last = std_fmemget(h + 1);
+  panic_ifn(val >= last);
+  bucket_push(h, bucket_idx(last, val), val);
+  std_fmemset(h, std_fmemget(h) + 1);
+}
+
+// Every value in bucket 0 is equal to last
+int_t heap_pop(int_t h) {
+  int_t len = std_fmemget(h);
+  panic_ifn(len > 0);
+  pull(h);
+
+  int_t bucket = bucket_addr(h, 0);
+  std_fmemset(bucket + 1, std_fmemget(bucket + 1) - 1);
+  std_fmemset(h, len - 1);
+  return std_fmemget(h + 1);
+}
+
+int_t heap_min(int_t h) {
+  panic_ifn(heap_size(h) > 0);
+  pull(h);
+  return std_fmemget(h + 1);
+}
+
+int_t heap_size(int_t h) { return std_fmemget(h); }
@@ -0,0 +1,297 @@
+#include "table.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// Implementation based on AVL tree (self-balancing Binary Search Tree)
+// BST: every node has a key, and 2 childs.
+// the left child has a key < parent key
+// the right child has a key > parent key
+// every child node may be NULL (no child)
+//
+// AVL: for every node, the heights of the left and right subtrees differ by at
+// most 1
+// => height(T) <= 1.44 log2(size(T)), whatever the insertion order
+// All operations are O(log(n))
+//
+// After an insertion or a deletion, the heights are updated by walking up the
+// parent pointers from the modified node to the root.
+// If a node is unbalanced (heights difference of 2), it's fixed with one or two
+// rotations.
+// No operation is recursive.
+//
+// Node layout: key, val, left, right, parent, height
+
+static int_t node_new(int_t key, int_t val, int_t parent) {
+  int_t node = fm_alloc(6);
+  std_fmemset(node, key);
+  std_fmemset(node + 1, val);
+  std_fmemset(node + 2, 0);
+  std_fmemset(node + 3, 0);
+  std_fmemset(node + 4, parent);
+  std_fmemset(node + 5, 1);
+  return node;
+}
+
+static int_t node_height(int_t node) {
+  return node ? std_fmemget(node + 5) : 0;
+}
+
+static void node_update_height(int_t node) {
+  int_t hl = node_height(std_fmemget(node + 2));
+  int_t hr = node_height(std_fmemget(node + 3));
+  std_fmemset(node + 5, 1 + (hl > hr ? hl : hr));
+}
+
+// Height of left subtree - height of right subtree
+static int_t node_balance(int_t node) {
+  return node_height(std_fmemget(node + 2)) -
+         node_height(std_fmemget(node + 3));
+}
+
+static int_t node_min(int_t node) {
+  int_t left = std_fmemget(node + 2);
+  while (left) {
+    node = left;
+    left = std_fmemget(node + 2);
+  }
+  return node;
+}
+
+// Search for an entry in the tree
+// Returns the node pointer if found, otherwhise 0
+static int_t node_find(int_t node, int_t key) {
+  while (node) {
+    int_t node_key = std_fmemget(node);
+    if (key < node_key)
+      node = std_fmemget(node + 2);
+    else if (key > node_key)
+      node = std_fmemget(node + 3);
+    else
+      return node;
+  }
+
+  return 0;
+}
+
+// Replace `old` by `node` as child of `parent` (or as root if parent is null)
+static void replace_child(int_t st, int_t parent, int_t old, int_t node) {
+  if (parent == 0)
+    std_fmemset(st, node);
+  else if (std_fmemget(parent + 2) == old)
+    std_fmemset(parent + 2, node);
+  else
+    std_fmemset(parent + 3, node);
+
+  if (node)
+    std_fmemset(node + 4, parent);
+}
+
+// Left rotation: x.right = y, with y.left = b
+// => y takes the place of x, x.right = b, and y.left = x
+// Returns the new subtree root
+static int_t rotate_left(int_t st, int_t x) {
+  int_t y = std_fmemget(x + 3);
+  int_t b = std_fmemget(y + 2);
+
+  replace_child(st, std_fmemget(x + 4), x, y);
+  std_fmemset(x + 3, b);
+  if (b)
+    std_fmemset(b + 4, x);
+  std_fmemset(y + 2, x);
+  std_fmemset(x + 4, y);
+
+  node_update_height(x);
+  node_update_height(y);
+  return y;
+}
+
+// Right rotation: mirror of rotate_left
+static int_t rotate_right(int_t st, int_t x) {
+  int_t y = std_fmemget(x + 2);
+  int_t b = std_fmemget(y + 3);
+
+  replace_child(st, std_fmemget(x + 4), x, y);
+  std_fmemset(x + 2, b);
+  if (b)
+    std_fmemset(b + 4, x);
+  std_fmemset(y + 3, x);
+  std_fmemset(x + 4, y);
+
+  node_update_height(x);
+  node_update_height(y);
+  return y;
+}
+
+// Walk up from `node` to the root, updating heights and fixing unbalanced
+// nodes
+// - left-left case: right rotation
+// - left-right case: left rotation of left child, then right rotation
+// - right-right and right-left cases: mirror
+static void rebalance(int_t st, int_t node) {
+  while (node) {
+    node_update_height(node);
+    int_t balance = node_balance(node);
+
+    if (balance > 1) {
+      if (node_balance(std_fmemget(node + 2)) < 0)
+        rotate_left(st, std_fmemget(node + 2));
+      node = rotate_right(st, node);
+    } else if (balance < -1) {
+      if (node_balance(std_fmemget(node + 3)) > 0)
+        rotate_right(st, std_fmemget(node + 3));
+      node = rotate_left(st, node);
+    }
+
+    node = std_fmemget(node + 4);
+  }
+}
+
+// Move to next node (in-order walk)
+// Returns null if node is the last one
+//
+// Algorithm
+// 1) If right child is not null, next is leftmost child of right
+// 2) Otherwhise move up until coming from a left child, next is this parent
+static int_t node_next(int_t node) {
+  int_t right = std_fmemget(node + 3);
+  if (right)
+    return node_min(right);
+
+  int_t parent = std_fmemget(node + 4);
+  while (parent ? std_fmemget(parent + 3) == node : 0) {
+    node = parent;
+    parent = std_fmemget(node + 4);
+  }
+  return parent;
+}
+
+int_t table_new() {
+  int_t st = fm_alloc(2);
+  std_fmemset(st, 0);
+  std_fmemset(st + 1, 0);
+  return st;
+}
+
+// Free all nodes without recursion:
+// go down to a leaf, free it, and go back to its parent
+void table_free(int_t st) {
+  int_t node = std_fmemget(st);
+  while (node) {
+    int_t left = std_fmemget(node + 2);
+    int_t right = std_fmemget(node + 3);
+    if (left) {
+      node = left;
+    } else if (right) {
+      node = right;
+    } else {
+      int_t parent = std_fmemget(node + 4);
+      if (parent)
+        replace_child(st, parent, node, 0);
+      fm_free(node);
+      node = parent;
+    }
+  }
+
+  fm_free(st);
+}
+
+int_t table_put(int_t st, int_t key, int_t val) {
+  int_t parent = 0;
+  int_t node_ptr = st;
+  int_t node = std_fmemget(node_ptr);
+
+  while (node) {
+    int_t node_key = std_fmemget(node);
+    if (key == node_key) {
+      std_fmemset(node + 1, val);
+      return 0;
+    }
+
+    parent = node;
+    node_ptr = key < node_key ? node + 2 : node + 3;
+    node = std_fmemget(node_ptr);
+  }
+
+  std_fmemset(node_ptr, node_new(key, val, parent));
+  rebalance(st, parent);
+  std_fmemset(st + 1, std_fmemget(st + 1) + 1);
+  return 1;
+}
+
+// If the node has 2 children, swap key/val with its successor (leftmost node
+// of right child), and remove the successor instead
+// The removed node has at most one child, which takes its place
+int_t table_delete(int_t st, int_t key) {
+  int_t node = node_find(std_fmemget(st), key);
+  if (node == 0)
+    return 0;
+
+  if (std_fmemget(node + 2) && std_fmemget(node + 3)) {
+    int_t rep = node_min(std_fmemget(node + 3));
+    std_fmemset(node, std_fmemget(rep));
+    std_fmemset(node + 1, std_fmemget(rep + 1));
+    node = rep;
+  }
+
+  int_t child = std_fmemget(node + 2) ? std_fmemget(node + 2)
+                                      : std_fmemget(node + 3);
+  int_t parent = std_fmemget(node + 4);
+  replace_child(st, parent, node, child);
+  fm_free(node);
+
+  rebalance(st, parent);
+  std_fmemset(st + 1, std_fmemget(st + 1) - 1);
+  return 1;
+}
+
+int_t table_get(int_t st, int_t key) {
+  int_t node = node_find(std_fmemget(st), key);
+  panic_ifn(node);
+  return std_fmemget(node + 1);
+}
+
+int_t table_contains(int_t st, int_t key) {
+  return (node_find(std_fmemget(st), key) == 0) == 0;
+}
+
+int_t table_size(int_t st) { return std_fmemget(st + 1); }
+
+// In-order walk
+// Visit left, visit node, visit right
+// Make sure all nodes are visited in key increase order
+
+int_t table_it_new(int_t st) {
+  int_t root = std_fmemget(st);
+  int_t node = root ? node_min(root) : 0;
+
+  int_t it = fm_alloc(1);
+  std_fmemset(it, node);
+  return it;
+}
+
+void table_it_free(int_t it) { fm_free(it); }
+
+int_t table_it_is_end(int_t it) {
+  int_t node = std_fmemget(it);
+  return node == 0;
+}
+
+int_t table_it_get_key(int_t it) {
+  int_t node = std_fmemget(it);
+  panic_ifn(node);
+  return std_fmemget(node);
+}
+
+int_t table_it_get_val(int_t it) {
+  int_t node = std_fmemget(it);
+  panic_ifn(node);
+  return std_fmemget(node + 1);
+}
+
+void table_it_next(int_t it) {
+  int_t node = std_fmemget(it);
+  if (node) {
+    node = node_next(node);
+  }
+  std_fmemset(it, node);
+}
@@ -255,9 +255,136 @@ void test4() {
   table_free(st);
 }
 
+void test5() {
+  int_t st = table_new();
+  int_t i = 0;
+  while (i < 53) {
+    table_put(st, (i * 17) % 53 * 3, i);
+    i = i + 1;
+  }
+  i = 0;
+  while (i < 14) {
+    printnl_int(table_delete(st, i * 12));
+    i = i + 1;
+  }
+
+  int_t min = table_min(st);
+  int_t max = table_max(st);
+  printnl_int(min);
+  printnl_int(max);
+
+  int_t k = -2;
+  while (k < 170) {
+    if (k >= min)
+      printnl_int(table_floor(st, k));
+    if (k <= max)
+      printnl_int(table_ceiling(st, k));
+    printnl_int(table_rank(st, k));
+    k = k + 7;
+  }
+
+  i = 0;
+  while (i < table_size(st)) {
+    printnl_int(table_select(st, i));
+    i = i + 5;
+  }
+
+  k = -5;
+  while (k < 170) {
+    printnl_int(table_range_count(st, k, k + 20));
+    k = k + 11;
+  }
+  printnl_int(table_range_count(st, 20, 10));
+
+  int_t it = table_it_new_from(st, 100);
+  while (table_it_is_end(it) == 0) {
+    printnl_int(table_it_get_key(it));
+    printnl_int(table_it_get_val(it));
+    table_it_next(it);
+  }
+  table_it_free(it);
+
+  it = table_it_new_from(st, 200);
+  printnl_int(table_it_is_end(it));
+  table_it_free(it);
+
+  table_free(st);
+}
+
+// Sorted insertions: degenerate tree with a height of n
+void test6() {
+  int_t st = table_new();
+  int_t n = 3000;
+  int_t i = 0;
+  while (i < n) {
+    table_put(st, i, 2 * i);
+    i = i + 1;
+  }
+
+  printnl_int(table_size(st));
+  printnl_int(table_get(st, n - 1));
+  printnl_int(table_rank(st, n / 2));
+  printnl_int(table_select(st, n - 3));
+  printnl_int(table_max(st));
+
+  i = 0;
+  while (i < n) {
+    table_delete(st, i);
+    i = i + 2;
+  }
+
+  printnl_int(table_size(st));
+  printnl_int(table_contains(st, 7));
+  printnl_int(table_contains(st, 8));
+  printnl_int(table_floor(st, 8));
+  printnl_int(table_rank(st, n - 1));
+  table_free(st);
+}
+
+void test7() {
+  int_t n = 200;
+  int_t keys = fm_alloc(n);
+  int_t vals = fm_alloc(n);
+
+  int_t i = 0;
+  while (i < n) {
+    std_fmemset(keys + i, 3 * i - 100);
+    std_fmemset(vals + i, i * i);
+    i = i + 1;
+  }
+  int_t st = table_from_sorted(keys, vals, n);
+  fm_free(keys);
+  fm_free(vals);
+
+  printnl_int(table_size(st));
+  printnl_int(table_min(st));
+  printnl_int(table_max(st));
+  printnl_int(table_rank(st, 0));
+  printnl_int(table_select(st, 57));
+  print_table(st);
+
+  i = -110;
+  while (i < 110) {
+    printnl_int(table_delete(st, i));
+    printnl_int(table_put(st, i + 1, i));
+    i = i + 5;
+  }
+  print_table(st);
+  table_free(st);
+
+  st = table_from_sorted(0, 0, 0);
+  printnl_int(table_size(st));
+  printnl_int(table_put(st, 4, 5));
+  print_table(st);
+  table_free(st);
+}
+
 int main() {
   test1();
   test2();
   test3();
   test4();
+  test5();
+  test6();
+  test7();
 }
@@ -4,6 +4,7 @@
 
 // Implementation based on BST (Binary Search Tree)
 // All operations are linear in the height of the tree.
+// No operation is recursive: a degenerate tree doesn't use any stack.
 // In average height(T) = ln(size(T))
 // But in wort cases all operations can be in O(n): depends on the insertion
 // order
@@ -12,25 +13,37 @@
 // the left child has a key < parent key
 // the right child has a key > parent key
 // every child node may be NULL (no child)
+//
+// Every node also keeps the size of its subtree, for the ordered operations
+// (rank / select)
+//
+// Node layout: key, val, left, right, parent, size
 
 static int_t node_new(int_t key, int_t val, int_t left, int_t right,
                       int_t parent) {
-  int_t node = fm_alloc(5);
+  int_t node = fm_alloc(6);
   std_fmemset(node, key);
   std_fmemset(node + 1, val);
   std_fmemset(node + 2, left);
   std_fmemset(node + 3, right);
   std_fmemset(node + 4, parent);
+  std_fmemset(node + 5, 1);
   return node;
 }
 
-static void node_free(int_t node) {
-  if (node) {
-    node_free(std_fmemget(node + 2));
-    node_free(std_fmemget(node + 3));
-    fm_free(node);
-  }
-}
+// Returns <0 if a < b, 0 if a == b, >0 if a > b
+// (a - b would overflow for keys far apart)
+// The keys are compared as integers, unless TABLE_KEY_CMP is defined to the
+// name of a function with the same contract, e.g. str_cmp to order string
+// keys (see strtable)
+#ifdef TABLE_KEY_CMP
+int_t TABLE_KEY_CMP(int_t a, int_t b);
+static int_t key_cmp(int_t a, int_t b) { return TABLE_KEY_CMP(a, b); }
+#else
+static int_t key_cmp(int_t a, int_t b) { return (a > b) - (a < b); }
+#endif
+
+static int_t node_size(int_t node) { return node ? std_fmemget(node + 5) : 0; }
 
 static void node_swap(int_t a, int_t b) {
   int_t a_key = std_fmemget(a);
@@ -43,106 +56,141 @@ static void node_swap(int_t a, int_t b) {
 
 static int_t node_min(int_t node) {
   int_t left = std_fmemget(node + 2);
-  return left == 0 ? node : node_min(left);
+  while (left) {
+    node = left;
+    left = std_fmemget(node + 2);
+  }
+  return node;
+}
+
+static int_t node_max(int_t node) {
+  int_t right = std_fmemget(node + 3);
+  while (right) {
+    node = right;
+    right = std_fmemget(node + 3);
+  }
+  return node;
 }
 
 // Search for an entry in the tree
 // Returns the node pointer if found, otherwhise 0
 //
-// Algorithm:
-// 1) if node is null => not found
-// 2) Compare key with node.key:
-//    - key < node.key => search in node.left
-//    - key > node.key => search in node.right
-//    - key == node.key => found
+// Algorithm: start at the root, until node is null:
+// Compare key with node.key:
+// - key < node.key => continue in node.left
+// - key > node.key => continue in node.right
+// - key == node.key => found
 static int_t node_find(int_t node, int_t key) {
-  if (node == 0) {
-    return 0;
-  } else {
-    int_t cmp = key - std_fmemget(node);
+  while (node) {
+    int_t cmp = key_cmp(key, std_fmemget(node));
     if (cmp < 0)
-      return node_find(std_fmemget(node + 2), key);
+      node = std_fmemget(node + 2);
     else if (cmp > 0)
-      return node_find(std_fmemget(node + 3), key);
+      node = std_fmemget(node + 3);
     else
       return node;
   }
+
+  return 0;
+}
+
+// Add `diff` to the size of node and all its ancestors
+static void node_add_size(int_t node, int_t diff) {
+  while (node) {
+    std_fmemset(node + 5, std_fmemget(node + 5) + diff);
+    node = std_fmemget(node + 4);
+  }
 }
 
 // Insert or update [key/val] in the right place in the tree
 // Returns 1 if insertion, 0 if update
 //
-// Algorithm:
-// 1)
+// Algorithm: go down from the root, keeping the pointer to the current child
+// slot:
 // - if key == node.key => update node.val = val
-// - if key < node.key => insert in node.left
-// - if key > node.key => insert in node.right
-// 2)
-// For recursive call, if left/right child is none, create new left/right child
-// with key/val pair, and no children
-static int_t node_put(int_t node_ptr, int_t parent, int_t key, int_t val) {
+// - if key < node.key => continue in node.left
+// - if key > node.key => continue in node.right
+// If the child slot is null, create a new node with key/val pair there, and
+// increment the sizes of all its ancestors
+static int_t node_put(int_t node_ptr, int_t key, int_t val) {
+  int_t parent = 0;
   int_t node = std_fmemget(node_ptr);
-  if (node == 0) {
-    std_fmemset(node_ptr, node_new(key, val, 0, 0, parent));
-    return 1;
-  } else {
-    int_t cmp = key - std_fmemget(node);
+
+  while (node) {
+    int_t cmp = key_cmp(key, std_fmemget(node));
     if (cmp == 0) {
       std_fmemset(node + 1, val);
       return 0;
-    } else {
-      int_t child_ptr = cmp < 0 ? node + 2 : node + 3;
-      return node_put(child_ptr, node, key, val);
     }
+
+    parent = node;
+    node_ptr = cmp < 0 ? node + 2 : node + 3;
+    node = std_fmemget(node_ptr);
   }
+
+  std_fmemset(node_ptr, node_new(key, val, 0, 0, parent));
+  node_add_size(parent, 1);
+  return 1;
 }
 
 // Remove entry from the tree
 // Returns 1 if entry found and deleted, 0 otherwhise
 //
 // Algorithm:
-// 1) If node is null, delete failed
-// 2) Compare key with node.key
-// - if key < node.key => recursive delete key in node.left
-// - if key > node.key => recursive delete key in node.right
-// - if key == node.key => found node, go to (3)
-//
-// 3) If one of the children is null, move up the other child
-// - if node.left is null, replace node with node.right
-// - else if node.right is null, replace node with node.left
-// - else => go to (4)
-//
-// 4) find a replacement node: either the rightmost node of left child, or
-// leftmost node or right child 5) swap key/val of replacement node with current
-// node 6) recursive delete of key in replacement node
-static int_t node_del(int_t node_ptr, int_t key) {
-  int_t node = std_fmemget(node_ptr);
-  if (node == 0) {
+// 1) Find the node, if null, delete failed
+// 2) If both children are not null, swap key/val with the replacement node:
+// leftmost node of right child, and remove the replacement node instead
+// 3) The removed node has at most one child: move up this child, its parent
+// becomes the parent of the removed node
+// 4) Decrement the sizes of all ancestors of the removed node
+static int_t node_del(int_t root_ptr, int_t key) {
+  int_t node = node_find(std_fmemget(root_ptr), key);
+  if (node == 0)
     return 0;
+
+  int_t right = std_fmemget(node + 3);
+  if (std_fmemget(node + 2) && right) {
+    int_t rep_node = node_min(right);
+    node_swap(node, rep_node);
+    node = rep_node;
   }
 
-  else {
-    int_t cmp = key - std_fmemget(node);
-    if (cmp) {
-      int_t child_ptr = cmp < 0 ? node + 2 : node + 3;
-      return node_del(child_ptr, key);
+  int_t left = std_fmemget(node + 2);
+  int_t child = left ? left : std_fmemget(node + 3);
+  int_t parent = std_fmemget(node + 4);
+
+  if (parent == 0)
+    std_fmemset(root_ptr, child);
+  else if (std_fmemget(parent + 2) == node)
+    std_fmemset(parent + 2, child);
+  else
+    std_fmemset(parent + 3, child);
+  if (child)
+    std_fmemset(child + 4, parent);
+
+  fm_free(node);
+  node_add_size(parent, -1);
+  return 1;
+}
+
+// Free all nodes without recursion, and without extra memory:
+// go down to a leaf, free it, detach it from its parent, and go back to the
+// parent
+static void node_free(int_t node) {
+  while (node) {
+    int_t left = std_fmemget(node + 2);
+    int_t right = std_fmemget(node + 3);
+    if (left) {
+      node = left;
+    } else if (right) {
+      node = right;
     } else {
-      int_t left = std_fmemget(node + 2);
-      int_t right = std_fmemget(node + 3);
-
-      if (left == 0) {
-        std_fmemset(node_ptr, right);
-        fm_free(node);
-      } else if (right == 0) {
-        std_fmemset(node_ptr, left);
-        fm_free(node);
-      } else {
-        int_t rep_node = node_min(right);
-        node_swap(node, rep_node);
-        panic_ifn(node_del(node + 3, key));
-      }
-
-      return 1;
+      int_t parent = std_fmemget(node + 4);
+      if (parent)
+        std_fmemset(std_fmemget(parent + 2) == node ? parent + 2 : parent + 3,
+                    0);
+      fm_free(node);
+      node = parent;
     }
   }
 }
@@ -155,21 +203,105 @@ static int_t node_del(int_t node_ptr, int_t key) {
 // 1) Try to go right
 // - if right child is not null, next is leftmost child of right
 // - if right child is null, go to step 2
-// 2) Move to the parent
+// 2) Move up until coming from a left child
 // - if parent is null, this was the last node to visit
 // - if moved up from left, next node is the parent
-// - if moved up from right, recursive node_next of parent
+// - if moved up from right, keep moving up (the parent was already visited)
 static int_t node_next(int_t node) {
   int_t right = std_fmemget(node + 3);
-  if (right) {
+  if (right)
     return node_min(right);
-  } else {
-    int_t parent = std_fmemget(node + 4);
-    if (parent == 0) {
-      return 0;
+
+  int_t parent = std_fmemget(node + 4);
+  while (parent ? std_fmemget(parent + 3) == node : 0) {
+    node = parent;
+    parent = std_fmemget(node + 4);
+  }
+  return parent;
+}
+
+// Returns the node with the largest key <= key, or 0 if none
+//
+// Algorithm: go down from the root, remembering the last node with node.key <
+// key
+// - key == node.key => found
+// - key < node.key => floor must be in node.left
+// - key > node.key => floor is either in node.right, or it's node
+static int_t node_floor(int_t node, int_t key) {
+  int_t res = 0;
+  while (node) {
+    int_t cmp = key_cmp(key, std_fmemget(node));
+    if (cmp == 0) {
+      return node;
+    } else if (cmp < 0) {
+      node = std_fmemget(node + 2);
     } else {
-      int_t from_left = std_fmemget(parent + 2) == node;
-      return from_left ? parent : node_next(parent);
+      res = node;
+      node = std_fmemget(node + 3);
+    }
+  }
+  return res;
+}
+
+// Returns the node with the smallest key >= key, or 0 if none
+// Mirror of node_floor
+static int_t node_ceiling(int_t node, int_t key) {
+  int_t res = 0;
+  while (node) {
+    int_t cmp = key_cmp(key, std_fmemget(node));
+    if (cmp == 0) {
+      return node;
+    } else if (cmp > 0) {
+      node = std_fmemget(node + 3);
+    } else {
+      res = node;
+      node = std_fmemget(node + 2);
+    }
+  }
+  return res;
+}
+
+// Returns the number of keys < key
+//
+// Algorithm: go down from the root, counting the keys left behind
+// - key == node.key => add all keys of node.left, done
+// - key < node.key => continue in node.left
+// - key > node.key => add all keys of node.left and node, continue in
+// node.right
+static int_t node_rank(int_t node, int_t key) {
+  int_t res = 0;
+  while (node) {
+    int_t cmp = key_cmp(key, std_fmemget(node));
+    int_t left = std_fmemget(node + 2);
+    if (cmp == 0) {
+      return res + node_size(left);
+    } else if (cmp < 0) {
+      node = left;
+    } else {
+      res = res + node_size(left) + 1;
+      node = std_fmemget(node + 3);
+    }
+  }
+  return res;
+}
+
+// Returns the node with rank k
+//
+// Algorithm: (t = size of node.left)
+// - k == t => node
+// - k < t => continue in node.left
+// - k > t => continue in node.right, with k = k - t - 1
+static int_t node_select(int_t node, int_t k) {
+  while (1) {
+    int_t left = std_fmemget(node + 2);
+    int_t t = node_size(left);
+    if (k == t) {
+      return node;
+    } else if (k < t) {
+      node = left;
+    } else {
+      node = std_fmemget(node + 3);
+      k = k - t - 1;
     }
   }
 }
@@ -181,13 +313,68 @@ int_t table_new() {
   return st;
 }
 
+// Build the tree top-down with an explicit stack of ranges [lo, hi[ of the
+// sorted arrays, and the child slot where their subtree goes
+// - the middle entry of the range becomes the subtree root
+// - [lo, mid[ goes to its left child, [mid + 1, hi[ to its right child
+// => height(T) = ceil(log2(n + 1)), the stack never has more than height + 1
+// ranges
+int_t table_from_sorted(int_t keys, int_t vals, int_t n) {
+  int_t i = 1;
+  while (i < n) {
+    panic_ifn(key_cmp(std_fmemget(keys + i - 1), std_fmemget(keys + i)) < 0);
+    i = i + 1;
+  }
+
+  int_t st = table_new();
+  std_fmemset(st + 1, n);
+
+  // Stack entries: lo, hi, child slot, parent
+  int_t stack = fm_alloc(4 * 34);
+  std_fmemset(stack, 0);
+  std_fmemset(stack + 1, n);
+  std_fmemset(stack + 2, st);
+  std_fmemset(stack + 3, 0);
+  int_t len = 1;
+
+  while (len) {
+    len = len - 1;
+    int_t top = stack + 4 * len;
+    int_t lo = std_fmemget(top);
+    int_t hi = std_fmemget(top + 1);
+    int_t slot = std_fmemget(top + 2);
+    int_t parent = std_fmemget(top + 3);
+
+    if (lo < hi) {
+      int_t mid = lo + (hi - lo) / 2;
+      int_t node = node_new(std_fmemget(keys + mid), std_fmemget(vals + mid),
+                            0, 0, parent);
+      std_fmemset(node + 5, hi - lo);
+      std_fmemset(slot, node);
+
+      std_fmemset(top, mid + 1);
+      std_fmemset(top + 1, hi);
+      std_fmemset(top + 2, node + 3);
+      std_fmemset(top + 3, node);
+      std_fmemset(top + 4, lo);
+      std_fmemset(top + 5, mid);
+      std_fmemset(top + 6, node + 2);
+      std_fmemset(top + 7, node);
+      len = len + 2;
+    }
+  }
+
+  fm_free(stack);
+  return st;
+}
+
 void table_free(int_t st) {
   node_free(std_fmemget(st));
   fm_free(st);
 }
 
 int_t table_put(int_t st, int_t key, int_t val) {
-  int_t res = node_put(st, 0, key, val);
+  int_t res = node_put(st, key, val);
   std_fmemset(st + 1, std_fmemget(st + 1) + res);
   return res;
 }
@@ -210,6 +397,45 @@ int_t table_contains(int_t st, int_t key) {
 
 int_t table_size(int_t st) { return std_fmemget(st + 1); }
 
+int_t table_min(int_t st) {
+  int_t root = std_fmemget(st);
+  panic_ifn(root);
+  return std_fmemget(node_min(root));
+}
+
+int_t table_max(int_t st) {
+  int_t root = std_fmemget(st);
+  panic_ifn(root);
+  return std_fmemget(node_max(root));
+}
+
+int_t table_floor(int_t st, int_t key) {
+  int_t node = node_floor(std_fmemget(st), key);
+  panic_ifn(node);
+  return std_fmemget(node);
+}
+
+int_t table_ceiling(int_t st, int_t key) {
+  int_t node = node_ceiling(std_fmemget(st), key);
+  panic_ifn(node);
+  return std_fmemget(node);
+}
+
+int_t table_rank(int_t st, int_t key) {
+  return node_rank(std_fmemget(st), key);
+}
+
+int_t table_select(int_t st, int_t k) {
+  panic_ifn(k >= 0 && k < table_size(st));
+  return std_fmemget(node_select(std_fmemget(st), k));
+}
+
+int_t table_range_count(int_t st, int_t lo, int_t hi) {
+  if (key_cmp(hi, lo) < 0)
+    return 0;
+  return table_rank(st, hi) - table_rank(st, lo) + table_contains(st, hi);
+}
+
 // In-order walk
 // Visit left, visit node, visit right
 // Make sure all nodes are visited in key increase order
@@ -223,6 +449,15 @@ int_t table_it_new(int_t st) {
   return it;
 }
 
+// Start the in-order walk at the ceiling of lo
+int_t table_it_new_from(int_t st, int_t lo) {
+  int_t node = node_ceiling(std_fmemget(st), lo);
+
+  int_t it = fm_alloc(1);
+  std_fmemset(it, node);
+  return it;
+}
+
 void table_it_free(int_t it) { fm_free(it); }
 
 int_t table_it_is_end(int_t it) {
@@ -12,6 +12,12 @@
 // Allocate memory for a new empty symbols table
 int_t table_new();
 
+// Allocate memory for a new symbols table, filled with the `n` entries
+// (keys[i], vals[i])
+// keys must be sorted in strictly increasing order (panic otherwhise)
+// The tree is perfectly balanced, and built in O(n)
+int_t table_from_sorted(int_t keys, int_t vals, int_t n);
+
 // Clear all the memory allocated for the symbols table
 void table_free(int_t st);
 
@@ -34,9 +40,43 @@ int_t table_contains(int_t st, int_t key);
 // Returns the number of elements in the symbols table
 int_t table_size(int_t st);
 
+// Ordered operations
+// Keys are sorted in increasing order (of integers, or of the TABLE_KEY_CMP
+// comparison if the table is built with it, see table.c)
+
+// Returns the smallest key
+// Panic if the table is empty
+int_t table_min(int_t st);
+
+// Returns the largest key
+// Panic if the table is empty
+int_t table_max(int_t st);
+
+// Returns the largest key <= key
+// Panic if there is none (key < table_min)
+int_t table_floor(int_t st, int_t key);
+
+// Returns the smallest key >= key
+// Panic if there is none (key > table_max)
+int_t table_ceiling(int_t st, int_t key);
+
+// Returns the number of keys < key
+int_t table_rank(int_t st, int_t key);
+
+// Returns the key with rank k (there is exactly k smaller keys)
+// Panic if k is not in [0, size[
+int_t table_select(int_t st, int_t k);
+
+// Returns the number of keys in [lo, hi]
+int_t table_range_count(int_t st, int_t lo, int_t hi);
+
 // Allocate memory for a table iterator, pointing to begining of symbols table
 int_t table_it_new(int_t st);
 
+// Allocate memory for a table iterator, pointing to the smallest key >= lo
+// Walking the iterator goes through all keys >= lo in increasing order
+int_t table_it_new_from(int_t st, int_t lo);
+
 // Free memory of table iterator
 void table_it_free(int_t it);
 
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <utility>
 #include <vector>
@@ -156,9 +157,93 @@ void test4() {
   print_table(st);
 }
 
+void test5() {
+  std::map<int, int> st;
+  for (int i = 0; i < 53; ++i)
+    table_put(st, (i * 17) % 53 * 3, i);
+  for (int i = 0; i < 14; ++i)
+    printnl_int(table_delete(st, i * 12));
+
+  int min = st.begin()->first;
+  int max = st.rbegin()->first;
+  printnl_int(min);
+  printnl_int(max);
+
+  for (int k = -2; k < 170; k += 7) {
+    if (k >= min)
+      printnl_int(std::prev(st.upper_bound(k))->first);
+    if (k <= max)
+      printnl_int(st.lower_bound(k)->first);
+    printnl_int(std::distance(st.begin(), st.lower_bound(k)));
+  }
+
+  for (std::size_t i = 0; i < st.size(); i += 5)
+    printnl_int(std::next(st.begin(), i)->first);
+
+  for (int k = -5; k < 170; k += 11)
+    printnl_int(std::distance(st.lower_bound(k), st.upper_bound(k + 20)));
+  printnl_int(0);
+
+  for (auto it = st.lower_bound(100); it != st.end(); ++it) {
+    printnl_int(it->first);
+    printnl_int(it->second);
+  }
+
+  printnl_int(st.lower_bound(200) == st.end());
+}
+
+void test6() {
+  std::map<int, int> st;
+  int n = 3000;
+  for (int i = 0; i < n; ++i)
+    table_put(st, i, 2 * i);
+
+  printnl_int(st.size());
+  printnl_int(st[n - 1]);
+  printnl_int(std::distance(st.begin(), st.lower_bound(n / 2)));
+  printnl_int(std::next(st.begin(), n - 3)->first);
+  printnl_int(st.rbegin()->first);
+
+  for (int i = 0; i < n; i += 2)
+    table_delete(st, i);
+
+  printnl_int(st.size());
+  printnl_int(table_contains(st, 7));
+  printnl_int(table_contains(st, 8));
+  printnl_int(std::prev(st.upper_bound(8))->first);
+  printnl_int(std::distance(st.begin(), st.lower_bound(n - 1)));
+}
+
+void test7() {
+  std::map<int, int> st;
+  for (int i = 0; i < 200; ++i)
+    st[3 * i - 100] = i * i;
+
+  printnl_int(st.size());
+  printnl_int(st.begin()->first);
+  printnl_int(st.rbegin()->first);
+  printnl_int(std::distance(st.begin(), st.lower_bound(0)));
+  printnl_int(std::next(st.begin(), 57)->first);
+  print_table(st);
+
+  for (int i = -110; i < 110; i += 5) {
+    printnl_int(table_delete(st, i));
+    printnl_int(table_put(st, i + 1, i));
+  }
+  print_table(st);
+
+  std::map<int, int> st2;
+  printnl_int(st2.size());
+  printnl_int(table_put(st2, 4, 5));
+  print_table(st2);
+}
+
 int main() {
   test1();
   test2();
   test3();
   test4();
+  test5();
+  test6();
+  test7();
 }
@@ -0,0 +1,398 @@
+#include "table.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// Implementation based on B+ tree
+// Every node holds up to B sorted keys in a flat array, and is read with a
+// binary search.
+// - internal nodes: n keys and n + 1 children
+//   child i contains the keys k such that key[i - 1] <= k < key[i]
+// - leaves: n keys and their values
+//   all entries are in the leaves, and the leaves are linked in key order
+// All leaves are at the same depth, and all nodes except the root have at
+// least MIN_KEYS keys
+// => height(T) = O(log_B(size(T))), whatever the insertion order
+// All operations are O(log(n)), and only read O(log_B(n)) nodes
+// In-order iteration is a sequential scan of the linked leaves
+//
+// Insertion (top-down): when going down, every full node is split before
+// entering it, so that there is always room in the parent for the new
+// separator key
+// Deletion (top-down): when going down, every node with MIN_KEYS keys gets one
+// more key before entering it, by borrowing from a sibling, or by merging with
+// a sibling
+// No operation is recursive.
+//
+// Node layout: is_leaf, n, next_leaf, keys[B], vals[B] (leaf) or
+// children[B + 1] (internal)
+
+#define B (32)
+#define MIN_KEYS (B / 2 - 1)
+
+static int_t node_new(int_t is_leaf) {
+  int_t node = fm_alloc(3 + 2 * B + 1);
+  std_fmemset(node, is_leaf);
+  std_fmemset(node + 1, 0);
+  std_fmemset(node + 2, 0);
+  return node;
+}
+
+static int_t node_is_leaf(int_t node) { return std_fmemget(node); }
+
+static int_t node_len(int_t node) { return std_fmemget(node + 1); }
+
+static void node_set_len(int_t node, int_t n) { std_fmemset(node + 1, n); }
+
+static int_t key_addr(int_t node, int_t i) { return node + 3 + i; }
+
+// Address of value i (leaf) or child i (internal node)
+static int_t slot_addr(int_t node, int_t i) { return node + 3 + B + i; }
+
+static int_t node_key(int_t node, int_t i) {
+  return std_fmemget(key_addr(node, i));
+}
+
+static int_t node_child(int_t node, int_t i) {
+  return std_fmemget(slot_addr(node, i));
+}
+
+// Returns the number of keys < key
+static int_t node_lower(int_t node, int_t key) {
+  int_t beg = 0;
+  int_t end = node_len(node);
+  while (beg < end) {
+    int_t mid = beg + (end - beg) / 2;
+    if (node_key(node, mid) < key)
+      beg = mid + 1;
+    else
+      end = mid;
+  }
+  return beg;
+}
+
+// Returns the number of keys <= key: index of the child that may contain key
+static int_t node_child_idx(int_t node, int_t key) {
+  int_t beg = 0;
+  int_t end = node_len(node);
+  while (beg < end) {
+    int_t mid = beg + (end - beg) / 2;
+    if (node_key(node, mid) <= key)
+      beg = mid + 1;
+    else
+      end = mid;
+  }
+  return beg;
+}
+
+// Returns the leaf that may contain key
+static int_t find_leaf(int_t st, int_t key) {
+  int_t node = std_fmemget(st);
+  while (node_is_leaf(node) == 0)
+    node = node_child(node, node_child_idx(node, key));
+  return node;
+}
+
+// Returns the address of the value of key, or 0 if not found
+static int_t find_val(int_t st, int_t key) {
+  int_t leaf = find_leaf(st, key);
+  int_t i = node_lower(leaf, key);
+  if (i < node_len(leaf) && node_key(leaf, i) == key)
+    return slot_addr(leaf, i);
+  return 0;
+}
+
+// Split the full child i of the parent node in 2 nodes
+// The middle key goes up in the parent, which must not be full
+// - leaf: the right node keeps a copy of the middle key
+// - internal node: the middle key is moved out
+static void split_child(int_t parent, int_t i) {
+  int_t node = node_child(parent, i);
+  int_t is_leaf = node_is_leaf(node);
+  int_t right = node_new(is_leaf);
+  int_t mid = B / 2;
+  int_t sep = node_key(node, mid);
+
+  if (is_leaf) {
+    std_fmemcpy(key_addr(right, 0), key_addr(node, mid), B - mid);
+    std_fmemcpy(slot_addr(right, 0), slot_addr(node, mid), B - mid);
+    node_set_len(right, B - mid);
+    std_fmemset(right + 2, std_fmemget(node + 2));
+    std_fmemset(node + 2, right);
+  } else {
+    std_fmemcpy(key_addr(right, 0), key_addr(node, mid + 1), B - mid - 1);
+    std_fmemcpy(slot_addr(right, 0), slot_addr(node, mid + 1), B - mid);
+    node_set_len(right, B - mid - 1);
+  }
+  node_set_len(node, mid);
+
+  int_t n = node_len(parent);
+  std_fmemcpy(key_addr(parent, i + 1), key_addr(parent, i), n - i);
+  std_fmemcpy(slot_addr(parent, i + 2), slot_addr(parent, i + 1), n - i);
+  std_fmemset(key_addr(parent, i), sep);
+  std_fmemset(slot_addr(parent, i + 1), right);
+  node_set_len(parent, n + 1);
+}
+
+// Move the last key of child i - 1 to child i
+static void borrow_left(int_t parent, int_t i) {
+  int_t node = node_child(parent, i);
+  int_t left = node_child(parent, i - 1);
+  int_t n = node_len(node);
+  int_t ln = node_len(left);
+
+  std_fmemcpy(key_addr(node, 1), key_addr(node, 0), n);
+  if (node_is_leaf(node)) {
+    std_fmemcpy(slot_addr(node, 1), slot_addr(node, 0), n);
+    std_fmemset(key_addr(node, 0), node_key(left, ln - 1));
+    std_fmemset(slot_addr(node, 0), node_child(left, ln - 1));
+    std_fmemset(key_addr(parent, i - 1), node_key(node, 0));
+  } else {
+    std_fmemcpy(slot_addr(node, 1), slot_addr(node, 0), n + 1);
+    std_fmemset(key_addr(node, 0), node_key(parent, i - 1));
+    std_fmemset(slot_addr(node, 0), node_child(left, ln));
+    std_fmemset(key_addr(parent, i - 1), node_key(left, ln - 1));
+  }
+
+  node_set_len(node, n + 1);
+  node_set_len(left, ln - 1);
+}
+
+// Move the first key of child i + 1 to child i
+static void borrow_right(int_t parent, int_t i) {
+  int_t node = node_child(parent, i);
+  int_t right = node_child(parent, i + 1);
+  int_t n = node_len(node);
+  int_t rn = node_len(right);
+
+  if (node_is_leaf(node)) {
+    std_fmemset(key_addr(node, n), node_key(right, 0));
+    std_fmemset(slot_addr(node, n), node_child(right, 0));
+    std_fmemcpy(key_addr(right, 0), key_addr(right, 1), rn - 1);
+    std_fmemcpy(slot_addr(right, 0), slot_addr(right, 1), rn - 1);
+    std_fmemset(key_addr(parent, i), node_key(right, 0));
+  } else {
+    std_fmemset(key_addr(node, n), node_key(parent, i));
+    std_fmemset(slot_addr(node, n + 1), node_child(right, 0));
+    std_fmemset(key_addr(parent, i), node_key(right, 0));
+    std_fmemcpy(key_addr(right, 0), key_addr(right, 1), rn - 1);
+    std_fmemcpy(slot_addr(right, 0), slot_addr(right, 1), rn);
+  }
+
+  node_set_len(node, n + 1);
+  node_set_len(right, rn - 1);
+}
+
+// Merge child i + 1 into child i, and remove separator i from the parent
+static void merge_children(int_t parent, int_t i) {
+  int_t node = node_child(parent, i);
+  int_t right = node_child(parent, i + 1);
+  int_t n = node_len(node);
+  int_t rn = node_len(right);
+
+  if (node_is_leaf(node)) {
+    std_fmemcpy(key_addr(node, n), key_addr(right, 0), rn);
+    std_fmemcpy(slot_addr(node, n), slot_addr(right, 0), rn);
+    std_fmemset(node + 2, std_fmemget(right + 2));
+    node_set_len(node, n + rn);
+  } else {
+    std_fmemset(key_addr(node, n), node_key(parent, i));
+    std_fmemcpy(key_addr(node, n + 1), key_addr(right, 0), rn);
+    std_fmemcpy(slot_addr(node, n + 1), slot_addr(right, 0), rn + 1);
+    node_set_len(node, n + 1 + rn);
+  }
+  fm_free(right);
+
+  int_t pn = node_len(parent);
+  std_fmemcpy(key_addr(parent, i), key_addr(parent, i + 1), pn - i - 1);
+  std_fmemcpy(slot_addr(parent, i + 1), slot_addr(parent, i + 2), pn - i - 1);
+  node_set_len(parent, pn - 1);
+}
+
+// Make sure child i has more than MIN_KEYS keys
+// Returns the child that now covers the keys of child i
+static int_t fix_child(int_t parent, int_t i) {
+  int_t n = node_len(parent);
+  int_t left = i > 0 ? node_child(parent, i - 1) : 0;
+  int_t right = i < n ? node_child(parent, i + 1) : 0;
+
+  if (left ? node_len(left) > MIN_KEYS : 0) {
+    borrow_left(parent, i);
+  } else if (right ? node_len(right) > MIN_KEYS : 0) {
+    borrow_right(parent, i);
+  } else if (left) {
+    merge_children(parent, i - 1);
+    return left;
+  } else {
+    merge_children(parent, i);
+  }
+
+  return node_child(parent, i);
+}
+
+int_t table_new() {
+  int_t st = fm_alloc(2);
+  std_fmemset(st, node_new(1));
+  std_fmemset(st + 1, 0);
+  return st;
+}
+
+// Depth-first walk with an explicit stack of (node, next child index)
+void table_free(int_t st) {
+  int_t root = std_fmemget(st);
+  int_t height = 1;
+  int_t node = root;
+  while (node_is_leaf(node) == 0) {
+    node = node_child(node, 0);
+    height = height + 1;
+  }
+
+  int_t stack = fm_alloc(2 * height);
+  int_t top = 0;
+  std_fmemset(stack, root);
+  std_fmemset(stack + 1, 0);
+
+  while (top >= 0) {
+    node = std_fmemget(stack + 2 * top);
+    int_t i = std_fmemget(stack + 2 * top + 1);
+    if (node_is_leaf(node) == 0 && i <= node_len(node)) {
+      std_fmemset(stack + 2 * top + 1, i + 1);
+      top = top + 1;
+      std_fmemset(stack + 2 * top, node_child(node, i));
+      std_fmemset(stack + 2 * top + 1, 0);
+    } else {
+      fm_free(node);
+      top = top - 1;
+    }
+  }
+
+  fm_free(stack);
+  fm_free(st);
+}
+
+int_t table_put(int_t st, int_t key, int_t val) {
+  int_t node = std_fmemget(st);
+  if (node_len(node) == B) {
+    int_t root = node_new(0);
+    std_fmemset(slot_addr(root, 0), node);
+    split_child(root, 0);
+    std_fmemset(st, root);
+    node = root;
+  }
+
+  while (node_is_leaf(node) == 0) {
+    int_t i = node_child_idx(node, key);
+    if (node_len(node_child(node, i)) == B) {
+      split_child(node, i);
+      i = node_child_idx(node, key);
+    }
+    node = node_child(node, i);
+  }
+
+  int_t n = node_len(node);
+  int_t i = node_lower(node, key);
+  if (i < n && node_key(node, i) == key) {
+    std_fmemset(slot_addr(node, i), val);
+    return 0;
+  }
+
+  std_fmemcpy(key_addr(node, i + 1), key_addr(node, i), n - i);
+  std_fmemcpy(slot_addr(node, i + 1), slot_addr(node, i), n - i);
+  std_fmemset(key_addr(node, i), key);
+  std_fmemset(slot_addr(node, i), val);
+  node_set_len(node, n + 1);
+  std_fmemset(st + 1, std_fmemget(st + 1) + 1);
+  return 1;
+}
+
+int_t table_delete(int_t st, int_t key) {
+  int_t node = std_fmemget(st);
+  while (node_is_leaf(node) == 0) {
+    int_t i = node_child_idx(node, key);
+    int_t child = node_child(node, i);
+    if (node_len(child) <= MIN_KEYS)
+      child = fix_child(node, i);
+    node = child;
+  }
+
+  // The root lost its last key after merging its 2 children
+  int_t root = std_fmemget(st);
+  if (node_is_leaf(root) == 0 && node_len(root) == 0) {
+    std_fmemset(st, node_child(root, 0));
+    fm_free(root);
+  }
+
+  int_t n = node_len(node);
+  int_t i = node_lower(node, key);
+  if (i < n && node_key(node, i) == key) {
+    std_fmemcpy(key_addr(node, i), key_addr(node, i + 1), n - i - 1);
+    std_fmemcpy(slot_addr(node, i), slot_addr(node, i + 1), n - i - 1);
+    node_set_len(node, n - 1);
+    std_fmemset(st + 1, std_fmemget(st + 1) - 1);
+    return 1;
+  } else {
+    return 0;
+  }
+}
+
+int_t table_get(int_t st, int_t key) {
+  int_t val_ptr = find_val(st, key);
+  panic_ifn(val_ptr);
+  return std_fmemget(val_ptr);
+}
+
+int_t table_contains(int_t st, int_t key) { return find_val(st, key) != 0; }
+
+int_t table_size(int_t st) { return std_fmemget(st + 1); }
+
+// Iterator: leaf, and index in the leaf
+// Walks through the linked leaves
+
+// Skip to the next leaf if the index is past the end of the leaf
+static void it_fix(int_t it) {
+  int_t leaf = std_fmemget(it);
+  int_t i = std_fmemget(it + 1);
+  while (leaf ? i == node_len(leaf) : 0) {
+    leaf = std_fmemget(leaf + 2);
+    i = 0;
+  }
+  std_fmemset(it, leaf);
+  std_fmemset(it + 1, i);
+}
+
+int_t table_it_new(int_t st) {
+  int_t leaf = std_fmemget(st);
+  while (node_is_leaf(leaf) == 0)
+    leaf = node_child(leaf, 0);
+
+  int_t it = fm_alloc(2);
+  std_fmemset(it, leaf);
+  std_fmemset(it + 1, 0);
+  it_fix(it);
+  return it;
+}
+
+void table_it_free(int_t it) { fm_free(it); }
+
+int_t table_it_is_end(int_t it) {
+  int_t leaf = std_fmemget(it);
+  return leaf == 0;
+}
+
+int_t table_it_get_key(int_t it) {
+  int_t leaf = std_fmemget(it);
+  panic_ifn(leaf);
+  return node_key(leaf, std_fmemget(it + 1));
+}
+
+int_t table_it_get_val(int_t it) {
+  int_t leaf = std_fmemget(it);
+  panic_ifn(leaf);
+  return node_child(leaf, std_fmemget(it + 1));
+}
+
+void table_it_next(int_t it) {
+  if (std_fmemget(it)) {
+    std_fmemset(it + 1, std_fmemget(it + 1) + 1);
+    it_fix(it);
+  }
+}
@@ -0,0 +1,87 @@
+// Multi-threaded benchmark of the symbols tables
+// The same driver is linked against a concurrent implementation of table.h,
+// and against a single-threaded one protected by one global mutex
+// (BENCH_GLOBAL_LOCK)
+//
+// n random entries, then every thread does 10n / threads random operations on
+// keys in [0, 2n[, with reads% lookups, and the rest split between put and
+// delete
+// A lookup is only table_contains: with concurrent deletes, a table_get after
+// it could fail
+
+extern "C" {
+#include "table.h"
+}
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using clk = std::chrono::steady_clock;
+
+#ifdef BENCH_GLOBAL_LOCK
+std::mutex &table_mutex() {
+  static std::mutex res;
+  return res;
+}
+#define TABLE_LOCK std::lock_guard<std::mutex> lock(table_mutex())
+#else
+#define TABLE_LOCK
+#endif
+
+void worker(int_t st, int n, int ops, int reads, int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<std::int32_t> key(0, 2 * n - 1);
+  std::uniform_int_distribution<int> op(0, 99);
+
+  for (int i = 0; i < ops; ++i) {
+    int_t k = key(rng);
+    int r = op(rng);
+    TABLE_LOCK;
+    if (r < reads)
+      table_contains(st, k);
+    else if (r % 2)
+      table_put(st, k, i);
+    else
+      table_delete(st, k);
+  }
+}
+
+void bench_mixed(int n, int reads, int threads) {
+  std::mt19937 rng(n);
+  std::uniform_int_distribution<std::int32_t> key(0, 2 * n - 1);
+  int_t st = table_new();
+  for (int i = 0; i < n; ++i)
+    table_put(st, key(rng), i);
+
+  int ops = 10 * n / threads;
+  auto start = clk::now();
+  std::vector<std::thread> pool;
+  for (int t = 0; t < threads; ++t)
+    pool.emplace_back(worker, st, n, ops, reads, t + 1);
+  for (auto &th : pool)
+    th.join();
+  double secs = std::chrono::duration<double>(clk::now() - start).count();
+
+  long total = static_cast<long>(ops) * threads;
+  std::cout << "read" << reads << "\t" << threads << "\t" << n << "\t" << total
+            << "\t" << secs * 1e3 << "\t" << total / secs / 1e6 << std::endl;
+
+  table_free(st);
+}
+
+} // namespace
+
+int main() {
+  std::cout << "workload\tthreads\tn\tops\ttime_ms\tMops/s" << std::endl;
+  int reads[] = {50, 90, 99};
+  for (int r : reads)
+    for (int threads = 1; threads <= 8; threads *= 2)
+      bench_mixed(100000, r, threads);
+}
@@ -0,0 +1,176 @@
+// Benchmark of the hash functions of hashfn.h
+// For every key set and every hash function, with n = 2^B keys and 2^B
+// buckets (high bits of the hash):
+// - max_load: number of keys in the fullest bucket
+// - avg_load: average load of the bucket of a key (sum of load^2 / n), the
+//   cost of a lookup with separate chaining, 1 + load factor = 2 for a random
+//   function
+// - Mhash/s: throughput of hash_of alone
+// - table_Mops/s: throughput of hashtable put + get with this hash function
+//
+// Key sets:
+// - seq: 0, 1, 2, ...
+// - stride: multiples of 1024
+// - high: only the 16 high bits vary
+// - cluster: 64 random bases, and consecutive keys after every base
+// - random: uniformly random
+// - adv_mult / adv_fmix: keys picked to all hash to bucket 0 with HASH_MULT /
+//   HASH_FMIX, by inverting the function (both are bijections). The seeded
+//   functions are not affected
+
+extern "C" {
+#include "hashfn.h"
+#include "lealloc.h"
+#include "table.h"
+}
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+using clk = std::chrono::steady_clock;
+
+const int B = 14;
+const int N = 1 << B;
+const int NB_HASHES = 10000000;
+
+const char *const HASH_NAMES[] = {"mult", "fmix", "mulshift", "seeded"};
+
+// Inverse of an odd number modulo 2^32 (Newton iterations)
+std::uint32_t inverse(std::uint32_t a) {
+  std::uint32_t x = a;
+  for (int i = 0; i < 5; ++i)
+    x *= 2 - a * x;
+  return x;
+}
+
+// Inverse of hash_fmix32
+std::uint32_t unfmix32(std::uint32_t h) {
+  h ^= h >> 16;
+  h *= inverse(0xc2b2ae35u);
+  h ^= (h >> 13) ^ (h >> 26);
+  h *= inverse(0x85ebca6bu);
+  h ^= h >> 16;
+  return h;
+}
+
+std::vector<int_t> keys_seq() {
+  std::vector<int_t> res(N);
+  for (int i = 0; i < N; ++i)
+    res[i] = i;
+  return res;
+}
+
+std::vector<int_t> keys_stride() {
+  std::vector<int_t> res(N);
+  for (int i = 0; i < N; ++i)
+    res[i] = i * 1024;
+  return res;
+}
+
+std::vector<int_t> keys_high() {
+  std::vector<int_t> res(N);
+  for (int i = 0; i < N; ++i)
+    res[i] = static_cast<int_t>(static_cast<std::uint32_t>(i) << 16);
+  return res;
+}
+
+std::vector<int_t> keys_cluster() {
+  std::mt19937 rng(1);
+  std::vector<int_t> res(N);
+  for (int i = 0; i < N; i += N / 64) {
+    int_t base = static_cast<int_t>(rng() & 0x7fff0000u);
+    for (int j = 0; j < N / 64; ++j)
+      res[i + j] = base + j;
+  }
+  return res;
+}
+
+std::vector<int_t> keys_random() {
+  std::mt19937 rng(2);
+  std::vector<int_t> res(N);
+  for (int i = 0; i < N; ++i)
+    res[i] = static_cast<int_t>(rng());
+  return res;
+}
+
+// Hashes with the B high bits at 0
+std::vector<int_t> keys_adv_mult() {
+  std::uint32_t inv = inverse(2654435761u);
+  std::vector<int_t> res(N);
+  for (int i = 0; i < N; ++i)
+    res[i] = static_cast<int_t>(static_cast<std::uint32_t>(i) * inv);
+  return res;
+}
+
+std::vector<int_t> keys_adv_fmix() {
+  std::vector<int_t> res(N);
+  for (int i = 0; i < N; ++i)
+    res[i] = static_cast<int_t>(unfmix32(static_cast<std::uint32_t>(i)));
+  return res;
+}
+
+void bench(const char *name, const std::vector<int_t> &keys, int_t kind,
+           int_t seed) {
+  std::vector<int> loads(N, 0);
+  for (int_t key : keys)
+    ++loads[hash_of(kind, seed, key) >> (32 - B)];
+  long sum_sq = 0;
+  for (int load : loads)
+    sum_sq += static_cast<long>(load) * load;
+  int max_load = *std::max_element(loads.begin(), loads.end());
+
+  volatile std::uint32_t sink = 0;
+  auto start = clk::now();
+  for (int i = 0; i < NB_HASHES; ++i)
+    sink = hash_of(kind, seed, keys[i % N]);
+  double hash_secs = std::chrono::duration<double>(clk::now() - start).count();
+
+  int_t st = table_new_hash(kind, seed);
+  start = clk::now();
+  for (int i = 0; i < N; ++i)
+    table_put(st, keys[i], i);
+  for (int i = 0; i < N; ++i)
+    sink = static_cast<std::uint32_t>(table_get(st, keys[i]));
+  double table_secs =
+      std::chrono::duration<double>(clk::now() - start).count();
+  table_free(st);
+  (void)sink;
+
+  std::cout << name << "\t" << HASH_NAMES[kind] << "\t" << max_load << "\t"
+            << static_cast<double>(sum_sq) / N << "\t"
+            << NB_HASHES / hash_secs / 1e6 << "\t"
+            << 2 * N / table_secs / 1e6 << std::endl;
+}
+
+} // namespace
+
+int main() {
+  std::random_device rd;
+  // Bit 1 set: never 0 or 1, invalid for HASH_MULSHIFT
+  int_t seed = static_cast<int_t>(rd() | 2u);
+
+  std::cout << "keys\thash\tmax_load\tavg_load\tMhash/s\ttable_Mops/s"
+            << std::endl;
+
+  const struct {
+    const char *name;
+    std::vector<int_t> (*gen)();
+  } key_sets[] = {
+      {"seq", keys_seq},           {"stride", keys_stride},
+      {"high", keys_high},         {"cluster", keys_cluster},
+      {"random", keys_random},     {"adv_mult", keys_adv_mult},
+      {"adv_fmix", keys_adv_fmix},
+  };
+
+  for (const auto &key_set : key_sets) {
+    std::vector<int_t> keys = key_set.gen();
+    for (int_t kind = HASH_MULT; kind <= HASH_SEEDED; ++kind)
+      bench(key_set.name, keys, kind, seed);
+  }
+}
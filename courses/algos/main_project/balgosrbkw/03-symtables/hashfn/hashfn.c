@@ -0,0 +1,35 @@
+#include "hashfn.h"
+#include "ledebug.h"
+
+uint32_t hash_mult(int_t x) { return (uint32_t)x * 2654435761u; }
+
+uint32_t hash_fmix32(int_t x) {
+  uint32_t h = (uint32_t)x;
+  h = h ^ (h >> 16);
+  h = h * 0x85ebca6bu;
+  h = h ^ (h >> 13);
+  h = h * 0xc2b2ae35u;
+  h = h ^ (h >> 16);
+  return h;
+}
+
+uint32_t hash_mulshift(int_t x, int_t seed) {
+  uint32_t a = (uint32_t)seed | 1u;
+  panic_ifn(a != 1u);
+  return (uint32_t)x * a;
+}
+
+uint32_t hash_seeded(int_t x, int_t seed) {
+  return hash_fmix32((int_t)((uint32_t)x ^ (uint32_t)seed));
+}
+
+uint32_t hash_of(int_t kind, int_t seed, int_t x) {
+  if (kind == HASH_MULT)
+    return hash_mult(x);
+  if (kind == HASH_FMIX)
+    return hash_fmix32(x);
+  if (kind == HASH_MULSHIFT)
+    return hash_mulshift(x, seed);
+  panic_ifn(kind == HASH_SEEDED);
+  return hash_seeded(x, seed);
+}
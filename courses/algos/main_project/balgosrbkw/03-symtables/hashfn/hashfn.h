@@ -0,0 +1,41 @@
+#ifndef HASHFN_H_
+#define HASHFN_H_
+
+#include "lestd.h"
+
+// Hash functions of integer keys, for the hash tables
+// All functions return a 32 bits hash whose high bits are well mixed: a table
+// of 2^b buckets must use the b high bits (h >> (32 - b)), not a modulo
+
+// Kinds of hash functions, to choose the hash function of a table at creation
+#define HASH_MULT (0)     // Multiplicative hashing, fixed multiplier
+#define HASH_FMIX (1)     // Murmur3 32 bits finalizer
+#define HASH_MULSHIFT (2) // Multiplicative hashing, seed as multiplier
+#define HASH_SEEDED (3)   // Murmur3 32 bits finalizer of the key xor seed
+
+// Multiplicative hashing: x * 2654435761 (2^32 / golden ratio)
+// Only one multiplication, the high bits depend on all key bits, but the low
+// bits only on the low bits of the key
+uint32_t hash_mult(int_t x);
+
+// Murmur3 32 bits finalizer: 2 multiplications and 3 xor-shifts
+// Every bit of the hash depends on every bit of the key (avalanche)
+uint32_t hash_fmix32(int_t x);
+
+// Multiply-shift (Dietzfelbinger): x * a, with a the seed forced odd
+// With a random seed, 2 different keys land in the same bucket of a table of
+// 2^b buckets with probability <= 2 / 2^b (universal family)
+// Panic if the seed is 0 or 1: the multiplier would be 1, the identity, and
+// all small keys would land in bucket 0
+uint32_t hash_mulshift(int_t x, int_t seed);
+
+// Seeded Murmur3 finalizer: fmix32(x xor seed)
+// Without the seed, an adversary can't pick keys colliding in the table
+uint32_t hash_seeded(int_t x, int_t seed);
+
+// Hash x with the function of kind `kind` (HASH_*), and seed `seed` (ignored
+// by the unseeded kinds)
+// Panic if the kind is unknown
+uint32_t hash_of(int_t kind, int_t seed, int_t x);
+
+#endif //! HASHFN_H_
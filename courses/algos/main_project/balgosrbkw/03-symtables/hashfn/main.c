@@ -0,0 +1,79 @@
+#include "hashfn.h"
+#include "lealloc.h"
+#include "leio.h"
+
+void print_hashes(int_t x) {
+  print_int((int_t)hash_mult(x));
+  std_putc(32);
+  print_int((int_t)hash_fmix32(x));
+  std_putc(32);
+  print_int((int_t)hash_mulshift(x, 12345678));
+  std_putc(32);
+  print_int((int_t)hash_seeded(x, 12345678));
+  printnl();
+}
+
+// Hash values of small, negative and extreme keys
+void test1() {
+  int_t i = -10;
+  while (i < 10) {
+    print_hashes(i);
+    i = i + 1;
+  }
+
+  print_hashes(2147483647);
+  print_hashes(-2147483647);
+  print_hashes(1 << 20);
+}
+
+// hash_of dispatches to the right function
+void test2() {
+  int_t kind = HASH_MULT;
+  while (kind <= HASH_SEEDED) {
+    int_t i = 0;
+    while (i < 5) {
+      print_int((int_t)hash_of(kind, -77, 1000 * i + 3));
+      std_putc(32);
+      i = i + 1;
+    }
+    printnl();
+    kind = kind + 1;
+  }
+}
+
+// Bucket loads of 256 keys multiple of 1024 in 64 buckets (high bits)
+void test3() {
+  int_t loads = fm_alloc(64);
+  int_t kind = HASH_MULT;
+  while (kind <= HASH_SEEDED) {
+    int_t i = 0;
+    while (i < 64) {
+      std_fmemset(loads + i, 0);
+      i = i + 1;
+    }
+
+    i = 0;
+    while (i < 256) {
+      int_t idx = (int_t)(hash_of(kind, 1103515245, 1024 * i) >> 26);
+      std_fmemset(loads + idx, std_fmemget(loads + idx) + 1);
+      i = i + 1;
+    }
+
+    int_t max = 0;
+    i = 0;
+    while (i < 64) {
+      if (std_fmemget(loads + i) > max)
+        max = std_fmemget(loads + i);
+      i = i + 1;
+    }
+    printnl_int(max);
+    kind = kind + 1;
+  }
+  fm_free(loads);
+}
+
+int main() {
+  test1();
+  test2();
+  test3();
+}
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+std::uint32_t hash_mult(std::int32_t x) {
+  return static_cast<std::uint32_t>(x) * 2654435761u;
+}
+
+std::uint32_t hash_fmix32(std::int32_t x) {
+  std::uint32_t h = static_cast<std::uint32_t>(x);
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h;
+}
+
+std::uint32_t hash_mulshift(std::int32_t x, std::int32_t seed) {
+  return static_cast<std::uint32_t>(x) * (static_cast<std::uint32_t>(seed) | 1u);
+}
+
+std::uint32_t hash_seeded(std::int32_t x, std::int32_t seed) {
+  return hash_fmix32(static_cast<std::int32_t>(static_cast<std::uint32_t>(x) ^
+                                               static_cast<std::uint32_t>(seed)));
+}
+
+std::uint32_t hash_of(int kind, std::int32_t seed, std::int32_t x) {
+  switch (kind) {
+  case 0:
+    return hash_mult(x);
+  case 1:
+    return hash_fmix32(x);
+  case 2:
+    return hash_mulshift(x, seed);
+  default:
+    return hash_seeded(x, seed);
+  }
+}
+
+int as_int(std::uint32_t h) { return static_cast<std::int32_t>(h); }
+
+void print_hashes(std::int32_t x) {
+  std::cout << as_int(hash_mult(x)) << " " << as_int(hash_fmix32(x)) << " "
+            << as_int(hash_mulshift(x, 12345678)) << " "
+            << as_int(hash_seeded(x, 12345678)) << std::endl;
+}
+
+void test1() {
+  for (int i = -10; i < 10; ++i)
+    print_hashes(i);
+
+  print_hashes(2147483647);
+  print_hashes(-2147483647);
+  print_hashes(1 << 20);
+}
+
+void test2() {
+  for (int kind = 0; kind <= 3; ++kind) {
+    for (int i = 0; i < 5; ++i)
+      std::cout << as_int(hash_of(kind, -77, 1000 * i + 3)) << " ";
+    std::cout << std::endl;
+  }
+}
+
+void test3() {
+  for (int kind = 0; kind <= 3; ++kind) {
+    std::vector<int> loads(64, 0);
+    for (int i = 0; i < 256; ++i)
+      ++loads[hash_of(kind, 1103515245, 1024 * i) >> 26];
+    std::cout << *std::max_element(loads.begin(), loads.end()) << std::endl;
+  }
+}
+
+int main() {
+  test1();
+  test2();
+  test3();
+}
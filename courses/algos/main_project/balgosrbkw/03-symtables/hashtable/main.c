@@ -1,4 +1,5 @@
 #include "lealloc.h"
+#include "hashfn.h"
 #include "leio.h"
 #include "table.h"
 
@@ -255,9 +256,191 @@ void test4() {
   table_free(st);
 }
 
+void test5() {
+  int_t st = table_new();
+  table_reserve(st, 500);
+  int_t i = 0;
+  while (i < 2000) {
+    table_put(st, 7 * i - 3000, i);
+    i = i + 1;
+  }
+  printnl_int(table_size(st));
+
+  i = 0;
+  while (i < 2000) {
+    if (i % 4)
+      printnl_int(table_delete(st, 7 * i - 3000));
+    i = i + 1;
+  }
+  printnl_int(table_size(st));
+
+  i = 0;
+  while (i < 40) {
+    printnl_int(table_contains(st, 7 * i - 3000));
+    i = i + 1;
+  }
+  print_table(st);
+
+  table_reserve(st, 3000);
+  i = 0;
+  while (i < 100) {
+    printnl_int(table_put(st, 3 * i, -i));
+    i = i + 1;
+  }
+  print_table(st);
+  table_free(st);
+}
+
+void test6() {
+  int_t st = table_new();
+  int_t n = 300;
+  int_t keys = fm_alloc(n);
+  int_t vals = fm_alloc(n);
+  int_t out = fm_alloc(n);
+
+  int_t i = 0;
+  while (i < n) {
+    std_fmemset(keys + i, 5 * (i % 200) - 700);
+    std_fmemset(vals + i, 2 * i + 1);
+    i = i + 1;
+  }
+  printnl_int(table_put_many(st, keys, vals, n));
+  print_table(st);
+
+  table_get_many(st, keys, n, out);
+  i = 0;
+  while (i < n) {
+    printnl_int(std_fmemget(out + i));
+    i = i + 1;
+  }
+
+  i = 0;
+  while (i < n) {
+    std_fmemset(keys + i, 3 * i - 750);
+    i = i + 1;
+  }
+  table_contains_many(st, keys, n, out);
+  i = 0;
+  while (i < n) {
+    printnl_int(std_fmemget(out + i));
+    i = i + 1;
+  }
+
+  fm_free(keys);
+  fm_free(vals);
+  fm_free(out);
+  table_free(st);
+}
+
+void test7() {
+  int_t n = 300;
+  int_t keys = fm_alloc(n);
+  int_t vals = fm_alloc(n);
+
+  int_t i = 0;
+  while (i < n) {
+    std_fmemset(keys + i, (i * 37) % 101 - 50);
+    std_fmemset(vals + i, 3 * i - 7);
+    i = i + 1;
+  }
+  int_t st = table_from_array(keys, vals, n);
+  fm_free(keys);
+  fm_free(vals);
+
+  printnl_int(table_size(st));
+  print_table(st);
+
+  i = -60;
+  while (i < 60) {
+    printnl_int(table_delete(st, i));
+    printnl_int(table_put(st, i + 30, i));
+    i = i + 4;
+  }
+  print_table(st);
+  table_free(st);
+
+  st = table_from_array(0, 0, 0);
+  printnl_int(table_size(st));
+  printnl_int(table_put(st, 4, 5));
+  print_table(st);
+  table_free(st);
+}
+
+// Same operations with every hash function
+void test8() {
+  int_t kind = HASH_MULT;
+  while (kind <= HASH_SEEDED) {
+    int_t st = table_new_hash(kind, -1640531527);
+    int_t i = 0;
+    while (i < 200) {
+      table_put(st, 1024 * (i % 150) - 5000, i);
+      i = i + 1;
+    }
+    printnl_int(table_size(st));
+
+    i = 0;
+    while (i < 100) {
+      printnl_int(table_delete(st, 2048 * i - 5000));
+      i = i + 3;
+    }
+    print_table(st);
+    printnl_int(table_get(st, 1024 * 9 - 5000));
+    printnl_int(table_contains(st, 1024 * 10 - 5000));
+    table_free(st);
+    kind = kind + 1;
+  }
+}
+
+// No resize after table_reserve / table_from_array
+// lealloc_v0 allocates from a top at fmem[0] and never frees: if the puts
+// don't resize, they only allocate their nodes (3 words each)
+void test9() {
+  int_t n = 1000;
+  int_t st = table_new();
+  table_reserve(st, n);
+  int_t top = std_fmemget(0);
+  int_t i = 0;
+  while (i < n) {
+    table_put(st, 11 * i - 400, i);
+    i = i + 1;
+  }
+  printnl_int(std_fmemget(0) - top - 3 * n);
+  printnl_int(table_size(st));
+  printnl_int(table_get(st, 11 * 500 - 400));
+
+  // One deletion may shrink back, but not below what the entries need
+  printnl_int(table_delete(st, -400));
+  top = std_fmemget(0);
+  table_put(st, -400, 0);
+  printnl_int(std_fmemget(0) - top - 3);
+  table_free(st);
+
+  int_t keys = fm_alloc(n);
+  int_t vals = fm_alloc(n);
+  i = 0;
+  while (i < n) {
+    std_fmemset(keys + i, 13 * i);
+    std_fmemset(vals + i, -i);
+    i = i + 1;
+  }
+  // Header (10 words), initial buckets (8), reserved buckets (1024), nodes
+  top = std_fmemget(0);
+  st = table_from_array(keys, vals, n);
+  printnl_int(std_fmemget(0) - top - 3 * n);
+  printnl_int(table_size(st));
+  fm_free(keys);
+  fm_free(vals);
+  table_free(st);
+}
+
 int main() {
   test1();
   test2();
   test3();
   test4();
+  test5();
+  test6();
+  test7();
+  test8();
+  test9();
 }
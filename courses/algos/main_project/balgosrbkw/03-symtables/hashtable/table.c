@@ -1,4 +1,5 @@
 #include "table.h"
+#include "hashfn.h"
 #include "lealloc.h"
 #include "ledebug.h"
 
@@ -6,6 +7,25 @@
 // Separate hasing is implemented using a linked list
 // Operations are amortized O(1)
 // (If hash function produce a normal distribution of its inputs)
+//
+// The number of buckets is a power of 2, doubled when there is more entries
+// than buckets, and halved when the buckets are 1/8 full.
+// Resizing is incremental: a second buckets array is allocated, and every
+// put / delete moves a few buckets from the old array to the new one.
+// While rehashing, keys can be in any of the 2 arrays, new keys are inserted
+// in the new one.
+// The new array isn't cleared when allocated: every step clears the new
+// buckets which receive the moved ones, just before moving them. Only this
+// prefix of the new array can be used (see new_ready).
+// => no operation pays the full rehash cost, nor the full clear cost
+//
+// Memory layout:
+// - st[0]: number of entries
+// - st[1]: index of the next bucket to rehash, -1 if not rehashing
+// - st[2 .. 4]: buckets array 0 (old): array, length, hash shift
+// - st[5 .. 7]: buckets array 1 (new): array, length, hash shift
+// - st[8]: kind of hash function (HASH_* of hashfn.h)
+// - st[9]: seed of the hash function
 
 // Create a new node to store the they, and set it's next element as the head of
 // the list
@@ -61,46 +81,177 @@ static int_t ll_find_ptr(int_t l_ptr, int_t key) {
   return target;
 }
 
-// Performs hashing of integer to integer
-static int_t hash_fn(int_t x) { return x * 2654435761; }
+#define MIN_LEN (8)
+#define REHASH_STEP (4)
+#define BATCH_SIZE (16)
 
-// Hash key and change the value to the right range to be an array index
-static int_t hash_key(int_t x, int_t len) {
-  x = hash_fn(x);
-  x = x > 0 ? x : -x;
-  return x % len;
+static int_t ht_addr(int_t st, int_t k) { return st + 2 + 3 * k; }
+
+// Returns the address of the head of the linked list of `key` in the buckets
+// array `ht`
+// The high bits of the hash are the best mixed, keep log2(len) of them
+static int_t bucket_addr(int_t st, int_t ht, int_t key) {
+  uint32_t h = hash_of(std_fmemget(st + 8), std_fmemget(st + 9), key);
+  int_t idx = (int_t)(h >> std_fmemget(ht + 2));
+  return std_fmemget(ht) + idx;
 }
 
-int_t table_new() {
-  int_t n = 37;
-  int_t st = fm_alloc(2 + n);
-  std_fmemset(st, n);
-  std_fmemset(st + 1, 0);
+// Clear the buckets [beg, end[ of the buckets array ht
+static void ht_clear(int_t ht, int_t beg, int_t end) {
+  int_t arr = std_fmemget(ht);
+  while (beg < end) {
+    std_fmemset(arr + beg, 0);
+    beg = beg + 1;
+  }
+}
 
-  int_t i = 0;
-  while (i < n) {
-    std_fmemset(st + 2 + i, 0);
-    i = i + 1;
+// Allocate a buckets array of length `len`, not cleared
+static void ht_init(int_t ht, int_t len) {
+  int_t shift = 32;
+  int_t n = len;
+  while (n > 1) {
+    n = n / 2;
+    shift = shift - 1;
   }
 
+  int_t arr = fm_alloc(len);
+  std_fmemset(ht, arr);
+  std_fmemset(ht + 1, len);
+  std_fmemset(ht + 2, shift);
+}
+
+static int_t is_rehashing(int_t st) { return std_fmemget(st + 1) != -1; }
+
+// Returns the number of buckets of the new array which receive the keys of
+// the old buckets [0, idx[
+// The high bits of the hash are kept: old bucket i goes to the new buckets
+// [i * f, (i + 1) * f[ when growing by a factor f, and to i / f when
+// shrinking by a factor f
+static int_t new_ready(int_t st, int_t idx) {
+  int_t old_len = std_fmemget(ht_addr(st, 0) + 1);
+  int_t new_len = std_fmemget(ht_addr(st, 1) + 1);
+  if (new_len >= old_len)
+    return idx * (new_len / old_len);
+  int_t f = old_len / new_len;
+  return (idx + f - 1) / f;
+}
+
+// Move `n` buckets of the old array to the new one
+// When all buckets are moved, the new array replaces the old one
+static void rehash_step(int_t st, int_t n) {
+  int_t ht0 = ht_addr(st, 0);
+  int_t ht1 = ht_addr(st, 1);
+  int_t idx = std_fmemget(st + 1);
+  int_t arr = std_fmemget(ht0);
+  int_t len = std_fmemget(ht0 + 1);
+
+  while (n > 0 && idx < len) {
+    ht_clear(ht1, new_ready(st, idx), new_ready(st, idx + 1));
+    int_t node = std_fmemget(arr + idx);
+    while (node) {
+      int_t next = std_fmemget(node + 2);
+      int_t head_ptr = bucket_addr(st, ht1, std_fmemget(node));
+      std_fmemset(node + 2, std_fmemget(head_ptr));
+      std_fmemset(head_ptr, node);
+      node = next;
+    }
+
+    std_fmemset(arr + idx, 0);
+    idx = idx + 1;
+    n = n - 1;
+  }
+
+  if (idx == len) {
+    fm_free(arr);
+    std_fmemcpy(ht0, ht1, 3);
+    idx = -1;
+  }
+  std_fmemset(st + 1, idx);
+}
+
+// Start rehashing to a new array of length `len`
+static void rehash_start(int_t st, int_t len) {
+  ht_init(ht_addr(st, 1), len);
+  std_fmemset(st + 1, 0);
+}
+
+// Grow if the load factor is too high, after an insertion
+// Never shrinks: a table sized by table_reserve keeps its length
+static void check_grow(int_t st) {
+  int_t len = std_fmemget(ht_addr(st, 0) + 1);
+  if (is_rehashing(st) == 0 && std_fmemget(st) > len)
+    rehash_start(st, 2 * len);
+}
+
+// Shrink if the load factor is too low, after a deletion
+static void check_shrink(int_t st) {
+  int_t len = std_fmemget(ht_addr(st, 0) + 1);
+  if (is_rehashing(st) == 0 && len > MIN_LEN && 8 * std_fmemget(st) <= len)
+    rehash_start(st, len / 2);
+}
+
+// Returns the address of the head of the linked list that may contains `key`
+// While rehashing, it's in the new array if the old bucket was already moved
+static int_t find_bucket(int_t st, int_t key) {
+  int_t head_ptr = bucket_addr(st, ht_addr(st, 0), key);
+  if (is_rehashing(st) &&
+      head_ptr - std_fmemget(ht_addr(st, 0)) < std_fmemget(st + 1))
+    head_ptr = bucket_addr(st, ht_addr(st, 1), key);
+  return head_ptr;
+}
+
+int_t table_new() { return table_new_hash(HASH_MULT, 0); }
+
+int_t table_new_hash(int_t kind, int_t seed) {
+  panic_ifn(kind >= HASH_MULT && kind <= HASH_SEEDED);
+  panic_ifn(kind != HASH_MULSHIFT || ((uint32_t)seed | 1u) != 1u);
+  int_t st = fm_alloc(10);
+  std_fmemset(st, 0);
+  std_fmemset(st + 1, -1);
+  ht_init(ht_addr(st, 0), MIN_LEN);
+  ht_clear(ht_addr(st, 0), 0, MIN_LEN);
+  std_fmemset(ht_addr(st, 1), 0);
+  std_fmemset(ht_addr(st, 1) + 1, 0);
+  std_fmemset(ht_addr(st, 1) + 2, 0);
+  std_fmemset(st + 8, kind);
+  std_fmemset(st + 9, seed);
+  return st;
+}
+
+// Size the table once for `n` entries, so that the insertions never resize
+// it, and insert them all with the batched put
+int_t table_from_array(int_t keys, int_t vals, int_t n) {
+  int_t st = table_new();
+  table_reserve(st, n);
+  table_put_many(st, keys, vals, n);
   return st;
 }
 
 void table_free(int_t st) {
-  int_t n = std_fmemget(st);
-  int_t i = 0;
-  while (i < n) {
-    ll_free(std_fmemget(st + 2 + i));
-    i = i + 1;
+  int_t k = 0;
+  while (k < 2) {
+    int_t ht = ht_addr(st, k);
+    int_t arr = std_fmemget(ht);
+    int_t n =
+        k == 0 ? std_fmemget(ht + 1) : new_ready(st, std_fmemget(st + 1));
+    int_t i = 0;
+    while (i < n) {
+      ll_free(std_fmemget(arr + i));
+      i = i + 1;
+    }
+    fm_free(arr);
+    k = k + (is_rehashing(st) ? 1 : 2);
   }
 
   fm_free(st);
 }
 
 int_t table_put(int_t st, int_t key, int_t val) {
-  int_t n = std_fmemget(st);
-  int_t idx = hash_key(key, n);
-  int_t head = std_fmemget(st + 2 + idx);
+  if (is_rehashing(st))
+    rehash_step(st, REHASH_STEP);
+
+  int_t head_ptr = find_bucket(st, key);
+  int_t head = std_fmemget(head_ptr);
   int_t node = ll_find(head, key);
 
   if (node) {
@@ -108,16 +259,18 @@ int_t table_put(int_t st, int_t key, int_t val) {
     return 0;
   } else {
     head = node_new(key, val, head);
-    std_fmemset(st + 2 + idx, head);
-    std_fmemset(st + 1, std_fmemget(st + 1) + 1);
+    std_fmemset(head_ptr, head);
+    std_fmemset(st, std_fmemget(st) + 1);
+    check_grow(st);
     return 1;
   }
 }
 
 int_t table_delete(int_t st, int_t key) {
-  int_t n = std_fmemget(st);
-  int_t idx = hash_key(key, n);
-  int_t head_ptr = st + 2 + idx;
+  if (is_rehashing(st))
+    rehash_step(st, REHASH_STEP);
+
+  int_t head_ptr = find_bucket(st, key);
   int_t node_ptr = ll_find_ptr(head_ptr, key);
 
   if (node_ptr) {
@@ -125,7 +278,8 @@ int_t table_delete(int_t st, int_t key) {
     panic_ifn(node);
     std_fmemset(node_ptr, std_fmemget(node + 2));
     fm_free(node);
-    std_fmemset(st + 1, std_fmemget(st + 1) - 1);
+    std_fmemset(st, std_fmemget(st) - 1);
+    check_shrink(st);
     return 1;
   } else {
     return 0;
@@ -133,28 +287,131 @@ int_t table_delete(int_t st, int_t key) {
 }
 
 int_t table_get(int_t st, int_t key) {
-  int_t n = std_fmemget(st);
-  int_t idx = hash_key(key, n);
-  int_t head = std_fmemget(st + 2 + idx);
+  int_t head = std_fmemget(find_bucket(st, key));
   int_t node = ll_find(head, key);
   panic_ifn(node);
   return std_fmemget(node + 1);
 }
 
 int_t table_contains(int_t st, int_t key) {
-  int_t n = std_fmemget(st);
-  int_t idx = hash_key(key, n);
-  int_t head = std_fmemget(st + 2 + idx);
+  int_t head = std_fmemget(find_bucket(st, key));
   return (ll_find(head, key) == 0) == 0;
 }
 
-int_t table_size(int_t st) { return std_fmemget(st + 1); }
+int_t table_size(int_t st) { return std_fmemget(st); }
+
+// Finish any rehashing, and then resize at once to a length >= n
+void table_reserve(int_t st, int_t n) {
+  if (is_rehashing(st))
+    rehash_step(st, std_fmemget(ht_addr(st, 0) + 1));
+
+  int_t len = std_fmemget(ht_addr(st, 0) + 1);
+  int_t new_len = len;
+  while (new_len < n)
+    new_len = 2 * new_len;
+
+  if (new_len > len) {
+    rehash_start(st, new_len);
+    rehash_step(st, len);
+  }
+}
+
+// Batched lookups
+// The keys are processed by chunks of BATCH_SIZE, in 3 passes:
+// 1) hash all keys, and prefetch their bucket
+// 2) read all bucket heads, and prefetch the first node
+// 3) walk the linked lists
+// => the cache misses of the whole chunk overlap, instead of waiting for each
+// one before computing the next address
+// Write in out[i] the node of keys[i], or 0 if not found
+static void batch_find(int_t st, int_t keys, int_t n, int_t out) {
+  int_t beg = 0;
+  while (beg < n) {
+    int_t end = beg + BATCH_SIZE < n ? beg + BATCH_SIZE : n;
+
+    int_t i = beg;
+    while (i < end) {
+      int_t head_ptr = find_bucket(st, std_fmemget(keys + i));
+      std_fmemprefetch(head_ptr);
+      std_fmemset(out + i, head_ptr);
+      i = i + 1;
+    }
+
+    i = beg;
+    while (i < end) {
+      int_t head = std_fmemget(std_fmemget(out + i));
+      std_fmemprefetch(head);
+      std_fmemset(out + i, head);
+      i = i + 1;
+    }
+
+    i = beg;
+    while (i < end) {
+      std_fmemset(out + i,
+                  ll_find(std_fmemget(out + i), std_fmemget(keys + i)));
+      i = i + 1;
+    }
+
+    beg = end;
+  }
+}
+
+void table_get_many(int_t st, int_t keys, int_t n, int_t out) {
+  batch_find(st, keys, n, out);
+  int_t i = 0;
+  while (i < n) {
+    int_t node = std_fmemget(out + i);
+    panic_ifn(node);
+    std_fmemset(out + i, std_fmemget(node + 1));
+    i = i + 1;
+  }
+}
+
+void table_contains_many(int_t st, int_t keys, int_t n, int_t out) {
+  batch_find(st, keys, n, out);
+  int_t i = 0;
+  while (i < n) {
+    std_fmemset(out + i, std_fmemget(out + i) != 0);
+    i = i + 1;
+  }
+}
+
+// Puts can move buckets (rehashing), so only the hashing and prefetching is
+// done ahead for the whole chunk
+int_t table_put_many(int_t st, int_t keys, int_t vals, int_t n) {
+  int_t res = 0;
+  int_t beg = 0;
+  while (beg < n) {
+    int_t end = beg + BATCH_SIZE < n ? beg + BATCH_SIZE : n;
+
+    int_t i = beg;
+    while (i < end) {
+      std_fmemprefetch(find_bucket(st, std_fmemget(keys + i)));
+      i = i + 1;
+    }
+
+    i = beg;
+    while (i < end) {
+      res = res + table_put(st, std_fmemget(keys + i), std_fmemget(vals + i));
+      i = i + 1;
+    }
+
+    beg = end;
+  }
+
+  return res;
+}
+
+// Iterator: node, bucket index, table, buckets array index
+// Walks through the buckets of the old array, then of the cleared prefix of
+// the new one (if rehashing)
 
 int_t table_it_new(int_t st) {
-  int_t it = fm_alloc(3);
+  int_t it = fm_alloc(4);
   std_fmemset(it, 0);
   std_fmemset(it + 1, -1);
   std_fmemset(it + 2, st);
+  std_fmemset(it + 3, 0);
   table_it_next(it);
   return it;
 }
@@ -182,28 +439,26 @@ void table_it_next(int_t it) {
   int_t node = std_fmemget(it);
   int_t idx = std_fmemget(it + 1);
   int_t st = std_fmemget(it + 2);
-  int_t n = std_fmemget(st);
-
-  if (idx < n) {
-    if (node)
-      node = std_fmemget(node + 2);
-    if (!node) {
-      int_t found = 0;
-      idx = idx + 1;
-      while (found == 0) {
-        if (idx == n) {
-          found = 1;
-        } else if (std_fmemget(st + 2 + idx)) {
-          found = 1;
-        } else {
-          idx = idx + 1;
-        }
-      }
-
-      node = idx < n ? std_fmemget(st + 2 + idx) : 0;
-      std_fmemset(it + 1, idx);
+  int_t k = std_fmemget(it + 3);
+  int_t nb_ht = is_rehashing(st) ? 2 : 1;
+
+  if (node)
+    node = std_fmemget(node + 2);
+
+  while (node == 0 && k < nb_ht) {
+    int_t ht = ht_addr(st, k);
+    int_t len =
+        k == 0 ? std_fmemget(ht + 1) : new_ready(st, std_fmemget(st + 1));
+    idx = idx + 1;
+    if (idx == len) {
+      k = k + 1;
+      idx = -1;
+    } else {
+      node = std_fmemget(std_fmemget(ht) + idx);
     }
-
-    std_fmemset(it, node);
   }
+
+  std_fmemset(it, node);
+  std_fmemset(it + 1, idx);
+  std_fmemset(it + 3, k);
 }
@@ -12,6 +12,19 @@
 // Allocate memory for a new empty symbols table
 int_t table_new();
 
+// Allocate memory for a new empty symbols table, hashing the keys with the
+// hash function of kind `kind` and seed `seed` (see hashfn.h)
+// The seeded kinds with a random seed resist adversarial keys
+// table_new uses HASH_MULT
+// Panic if the kind is unknown, or if the seed is invalid for the kind
+// (HASH_MULSHIFT with seed 0 or 1)
+int_t table_new_hash(int_t kind, int_t seed);
+
+// Allocate memory for a new symbols table, filled with the `n` entries
+// (keys[i], vals[i])
+// If a key appears several times, the last value is kept
+int_t table_from_array(int_t keys, int_t vals, int_t n);
+
 // Clear all the memory allocated for the symbols table
 void table_free(int_t st);
 
@@ -34,6 +47,24 @@ int_t table_contains(int_t st, int_t key);
 // Returns the number of elements in the symbols table
 int_t table_size(int_t st);
 
+// Make room for at least `n` elements, so that inserting up to `n` elements
+// doesn't trigger any resize
+void table_reserve(int_t st, int_t n);
+
+// Batched table_get: write in out[i] the value associated with keys[i]
+// keys and out are arrays of `n` entries, out must not overlap keys
+// Panic if one of the keys is not found
+void table_get_many(int_t st, int_t keys, int_t n, int_t out);
+
+// Batched table_contains: write in out[i] 1 if keys[i] is found, 0 otherwhise
+// keys and out are arrays of `n` entries, out must not overlap keys
+void table_contains_many(int_t st, int_t keys, int_t n, int_t out);
+
+// Batched table_put: add or update all entries (keys[i], vals[i])
+// keys and vals are arrays of `n` entries
+// Returns the number of insertions
+int_t table_put_many(int_t st, int_t keys, int_t vals, int_t n);
+
 // Allocate memory for a table iterator, pointing to begining of symbols table
 int_t table_it_new(int_t st);
 
@@ -156,9 +156,101 @@ void test4() {
   print_table(st);
 }
 
+void test5() {
+  std::map<int, int> st;
+  for (int i = 0; i < 2000; ++i)
+    table_put(st, 7 * i - 3000, i);
+  printnl_int(st.size());
+
+  for (int i = 0; i < 2000; ++i)
+    if (i % 4)
+      printnl_int(table_delete(st, 7 * i - 3000));
+  printnl_int(st.size());
+
+  for (int i = 0; i < 40; ++i)
+    printnl_int(table_contains(st, 7 * i - 3000));
+  print_table(st);
+
+  for (int i = 0; i < 100; ++i)
+    printnl_int(table_put(st, 3 * i, -i));
+  print_table(st);
+}
+
+void test6() {
+  std::map<int, int> st;
+  int n = 300;
+  std::vector<int> keys(n);
+  std::vector<int> vals(n);
+
+  int ins = 0;
+  for (int i = 0; i < n; ++i) {
+    keys[i] = 5 * (i % 200) - 700;
+    vals[i] = 2 * i + 1;
+    ins += table_put(st, keys[i], vals[i]);
+  }
+  printnl_int(ins);
+  print_table(st);
+
+  for (int i = 0; i < n; ++i)
+    printnl_int(st[keys[i]]);
+
+  for (int i = 0; i < n; ++i)
+    printnl_int(table_contains(st, 3 * i - 750));
+}
+
+void test7() {
+  std::map<int, int> st;
+  for (int i = 0; i < 300; ++i)
+    st[(i * 37) % 101 - 50] = 3 * i - 7;
+
+  printnl_int(st.size());
+  print_table(st);
+
+  for (int i = -60; i < 60; i += 4) {
+    printnl_int(table_delete(st, i));
+    printnl_int(table_put(st, i + 30, i));
+  }
+  print_table(st);
+
+  std::map<int, int> st2;
+  printnl_int(st2.size());
+  printnl_int(table_put(st2, 4, 5));
+  print_table(st2);
+}
+
+void test8() {
+  for (int kind = 0; kind < 4; ++kind) {
+    std::map<int, int> st;
+    for (int i = 0; i < 200; ++i)
+      st[1024 * (i % 150) - 5000] = i;
+    printnl_int(st.size());
+
+    for (int i = 0; i < 100; i += 3)
+      printnl_int(table_delete(st, 2048 * i - 5000));
+    print_table(st);
+    printnl_int(st[1024 * 9 - 5000]);
+    printnl_int(table_contains(st, 1024 * 10 - 5000));
+  }
+}
+
+void test9() {
+  printnl_int(0);
+  printnl_int(1000);
+  printnl_int(500);
+  printnl_int(1);
+  printnl_int(0);
+  printnl_int(10 + 8 + 1024);
+  printnl_int(1000);
+}
+
 int main() {
   test1();
   test2();
   test3();
   test4();
+  test5();
+  test6();
+  test7();
+  test8();
+  test9();
 }
@@ -0,0 +1,464 @@
+#include "lealloc.h"
+#include "leio.h"
+#include "table.h"
+
+int_t cmp(int_t arr, int_t i, int_t j) {
+  return std_fmemget(arr + i) - std_fmemget(arr + j);
+}
+void swap(int_t arr, int_t i, int_t j) {
+  int_t vi = std_fmemget(arr + i);
+  std_fmemset(arr + i, std_fmemget(arr + j));
+  std_fmemset(arr + j, vi);
+}
+void sort(int_t arr, int_t len) {
+  int_t i = 0;
+  while (i < len) {
+
+    int_t j = i;
+    while (j > 0 && cmp(arr, j, j - 1) < 0) {
+      swap(arr, j, j - 1);
+      j = j - 1;
+    }
+
+    i = i + 1;
+  }
+}
+void print_arr(int_t arr, int_t len) {
+  sort(arr, len);
+  std_putc(91);
+
+  int_t i = 0;
+  while (i < len) {
+    print_int(std_fmemget(arr + i));
+    if (i + 1 < len) {
+      std_putc(44);
+      std_putc(32);
+    }
+    i = i + 1;
+  }
+
+  std_putc(93);
+  std_putc(10);
+}
+
+void sort2(int_t arr1, int arr2, int_t len) {
+  int_t i = 0;
+  while (i < len) {
+
+    int_t j = i;
+    while (j > 0 && cmp(arr1, j, j - 1) < 0) {
+      swap(arr1, j, j - 1);
+      swap(arr2, j, j - 1);
+      j = j - 1;
+    }
+
+    i = i + 1;
+  }
+}
+void print_arr2(int_t arr1, int arr2, int_t len) {
+  sort2(arr1, arr2, len);
+  std_putc(91);
+
+  int_t i = 0;
+  while (i < len) {
+    std_putc(40);
+    print_int(std_fmemget(arr1 + i));
+    std_putc(59);
+    print_int(std_fmemget(arr2 + i));
+    std_putc(41);
+    if (i + 1 < len) {
+      std_putc(44);
+      std_putc(32);
+    }
+    i = i + 1;
+  }
+
+  std_putc(93);
+  std_putc(10);
+}
+
+void print_keys(int_t st) {
+  int_t len = table_size(st);
+  int_t keys = fm_alloc(len);
+  int_t it = table_it_new(st);
+  int_t i = 0;
+
+  while (i < len) {
+    std_fmemset(keys + i, table_it_get_key(it));
+    table_it_next(it);
+    i = i + 1;
+  }
+
+  print_arr(keys, len);
+  table_it_free(it);
+  fm_free(keys);
+}
+
+void print_vals(int_t st) {
+  int_t len = table_size(st);
+  int_t vals = fm_alloc(len);
+  int_t it = table_it_new(st);
+  int_t i = 0;
+
+  while (i < len) {
+    std_fmemset(vals + i, table_it_get_val(it));
+    table_it_next(it);
+    i = i + 1;
+  }
+
+  print_arr(vals, len);
+  table_it_free(it);
+  fm_free(vals);
+}
+
+void print_table(int_t st) {
+  int_t len = table_size(st);
+  int_t keys = fm_alloc(len);
+  int_t vals = fm_alloc(len);
+  int_t it = table_it_new(st);
+  int_t i = 0;
+
+  while (i < len) {
+    std_fmemset(keys + i, table_it_get_key(it));
+    std_fmemset(vals + i, table_it_get_val(it));
+    table_it_next(it);
+    i = i + 1;
+  }
+
+  print_arr2(keys, vals, len);
+  table_it_free(it);
+  fm_free(keys);
+  fm_free(vals);
+}
+
+void test1() {
+  int_t st = table_new();
+  print_keys(st);
+  print_vals(st);
+  print_table(st);
+  table_free(st);
+}
+
+void test2() {
+  int_t st = table_new();
+  printnl_int(table_put(st, 3, 78));
+  printnl_int(table_put(st, 6, 4));
+  printnl_int(table_put(st, 2, 45));
+  printnl_int(table_put(st, 1, 27));
+  printnl_int(table_put(st, 2, 37));
+  printnl_int(table_put(st, 8, 44));
+
+  int_t i = 0;
+  while (i < 10) {
+    printnl_int(table_contains(st, i));
+    i = i + 1;
+  }
+
+  print_keys(st);
+  print_vals(st);
+  print_table(st);
+  table_free(st);
+}
+
+void test3() {
+  int_t st = table_new();
+  int_t i = 0;
+  while (i < 20) {
+    printnl_int(table_put(st, i, i * i));
+    i = i + 1;
+  }
+
+  i = 0;
+  while (i < 20) {
+    printnl_int(table_contains(st, i));
+    i = i + 1;
+  }
+  print_table(st);
+
+  i = 0;
+  while (i < 20) {
+    printnl_int(table_delete(st, i));
+    i = i + 1;
+  }
+
+  print_table(st);
+  table_free(st);
+}
+
+void test4() {
+  int_t st = table_new();
+  int_t i = -40;
+  while (i < 40) {
+    printnl_int(table_put(st, i, i * i));
+    i = i + 1;
+  }
+
+  i = -40;
+  while (i < 40) {
+    printnl_int(table_contains(st, i));
+    i = i + 1;
+  }
+  print_table(st);
+
+  i = -12;
+  while (i < 4) {
+    printnl_int(table_delete(st, i));
+    i = i + 1;
+  }
+
+  i = -40;
+  while (i < 40) {
+    printnl_int(table_contains(st, i));
+    i = i + 1;
+  }
+  print_table(st);
+
+  i = 4;
+  while (i < 28) {
+    printnl_int(table_put(st, i, 4 * i * i - 5));
+    i = i + 1;
+  }
+
+  i = -40;
+  while (i < 40) {
+    printnl_int(table_contains(st, i));
+    i = i + 1;
+  }
+  print_table(st);
+
+  i = -37;
+  while (i < 8) {
+    printnl_int(table_delete(st, i));
+    i = i + 1;
+  }
+
+  i = -40;
+  while (i < 40) {
+    printnl_int(table_contains(st, i));
+    i = i + 1;
+  }
+  print_table(st);
+
+  i = 16;
+  while (i < 39) {
+    printnl_int(table_put(st, i, -2 * i + 50));
+    i = i + 1;
+  }
+
+  i = -40;
+  while (i < 40) {
+    printnl_int(table_contains(st, i));
+    i = i + 1;
+  }
+  print_table(st);
+
+  table_free(st);
+}
+
+// Sorted insertions: the worst case of an unbalanced BST
+void test5() {
+  int_t st = table_new();
+  int_t i = 0;
+  while (i < 5000) {
+    table_put(st, i, 2 * i);
+    i = i + 1;
+  }
+  i = 0;
+  while (i < 5000) {
+    table_put(st, -i - 1, i);
+    i = i + 1;
+  }
+  printnl_int(table_size(st));
+
+  i = 0;
+  while (i < 5000) {
+    if (i % 3)
+      table_delete(st, i);
+    i = i + 1;
+  }
+  printnl_int(table_size(st));
+
+  i = -20;
+  while (i < 20) {
+    printnl_int(table_contains(st, i));
+    i = i + 1;
+  }
+  print_table(st);
+  table_free(st);
+}
+
+// Iteration order, from the begining and from a key
+void test6() {
+  int_t st = table_new();
+  int_t i = 0;
+  while (i < 200) {
+    table_put(st, (i * 37) % 211 - 100, i);
+    i = i + 1;
+  }
+  i = 0;
+  while (i < 200) {
+    table_delete(st, (i * 53) % 211 - 100);
+    i = i + 3;
+  }
+
+  int_t it = table_it_new(st);
+  while (table_it_is_end(it) == 0) {
+    print_int(table_it_get_key(it));
+    std_putc(32);
+    table_it_next(it);
+  }
+  printnl();
+  table_it_free(it);
+
+  int_t lo = -120;
+  while (lo < 130) {
+    it = table_it_new_from(st, lo);
+    i = 0;
+    while (i < 5 && table_it_is_end(it) == 0) {
+      print_int(table_it_get_key(it));
+      std_putc(59);
+      print_int(table_it_get_val(it));
+      std_putc(32);
+      table_it_next(it);
+      i = i + 1;
+    }
+    printnl_int(table_it_is_end(it));
+    table_it_free(it);
+    lo = lo + 17;
+  }
+  table_free(st);
+}
+
+// Context of the threads of test7:
+// - ctx[0]: table
+// - ctx[1]: number of writers
+// - ctx[2]: number of successful insertions
+// - ctx[3]: number of successful deletions
+// - ctx[4]: number of wrong values or orders seen
+//
+// All writers work on the same keys [0, 2 K[:
+// - keys [0, K[ are put and deleted by all the writers
+// - keys [K, 2 K[ are put before the threads start, then only updated: the
+//   writers can table_get them, it never fails
+// Writer w writes the value 4 key + w, so a value is valid iff val / 4 == key
+// and val % 4 is a writer
+#define MIX_KEYS (256)
+
+int_t is_valid(int_t ctx, int_t key, int_t val) {
+  return val / 4 == key && val % 4 < std_fmemget(ctx + 1);
+}
+
+// Every round visits all the keys in a different order, and does one of put /
+// delete / contains on each, with a get of an updated key
+void mix_writer(int_t ctx, int_t w) {
+  int_t st = std_fmemget(ctx);
+  int_t nb_ins = 0;
+  int_t nb_del = 0;
+  int_t wrong = 0;
+  int_t r = 0;
+  while (r < 100) {
+    int_t i = 0;
+    while (i < MIX_KEYS) {
+      int_t k = (97 * i + 61 * w + 13 * r) % MIX_KEYS;
+      int_t op = (i + w + r) % 3;
+      if (op == 0)
+        nb_ins = nb_ins + table_put(st, k, 4 * k + w);
+      else if (op == 1)
+        nb_del = nb_del + table_delete(st, k);
+      else
+        table_contains(st, k);
+
+      int_t g = MIX_KEYS + (k + r) % MIX_KEYS;
+      table_put(st, MIX_KEYS + k, 4 * (MIX_KEYS + k) + w);
+      wrong = wrong + (is_valid(ctx, g, table_get(st, g)) == 0);
+      i = i + 1;
+    }
+    r = r + 1;
+  }
+
+  std_fmemxadd(ctx + 2, nb_ins);
+  std_fmemxadd(ctx + 3, nb_del);
+  std_fmemxadd(ctx + 4, wrong);
+}
+
+// Walks the table while the writers run: the keys must be increasing, and the
+// values valid
+void mix_walker(int_t ctx) {
+  int_t wrong = 0;
+  int_t pass = 0;
+  while (pass < 20) {
+    int_t prev = -1;
+    int_t it = table_it_new(std_fmemget(ctx));
+    while (table_it_is_end(it) == 0) {
+      int_t key = table_it_get_key(it);
+      wrong = wrong + (key <= prev) +
+              (is_valid(ctx, key, table_it_get_val(it)) == 0);
+      prev = key;
+      table_it_next(it);
+    }
+    table_it_free(it);
+    pass = pass + 1;
+  }
+  std_fmemxadd(ctx + 4, wrong);
+}
+
+void mix_thread(int_t ctx, int_t idx) {
+  if (idx < std_fmemget(ctx + 1))
+    mix_writer(ctx, idx);
+  else
+    mix_walker(ctx);
+}
+
+// 4 writers on the same keys, and 1 walker
+// The final table must match the successful operations: size = insertions -
+// deletions, and every key found once with a valid value
+void test7() {
+  int_t st = table_new();
+  int_t k = MIX_KEYS;
+  while (k < 2 * MIX_KEYS) {
+    table_put(st, k, 4 * k);
+    k = k + 1;
+  }
+
+  int_t ctx = fm_alloc(5);
+  std_fmemset(ctx, st);
+  std_fmemset(ctx + 1, 4);
+  std_fmemset(ctx + 2, 0);
+  std_fmemset(ctx + 3, 0);
+  std_fmemset(ctx + 4, 0);
+  std_parallel(5, mix_thread, ctx);
+  printnl_int(std_fmemget(ctx + 4));
+
+  int_t nb_low = std_fmemget(ctx + 2) - std_fmemget(ctx + 3);
+  printnl_int(table_size(st) == nb_low + MIX_KEYS);
+
+  int_t wrong = 0;
+  int_t count = 0;
+  int_t prev = -1;
+  int_t it = table_it_new(st);
+  while (table_it_is_end(it) == 0) {
+    int_t key = table_it_get_key(it);
+    wrong = wrong + (key <= prev) +
+            (is_valid(ctx, key, table_it_get_val(it)) == 0) +
+            (table_contains(st, key) == 0);
+    count = count + (key < MIX_KEYS);
+    prev = key;
+    table_it_next(it);
+  }
+  table_it_free(it);
+  printnl_int(wrong);
+  printnl_int(count == nb_low);
+
+  fm_free(ctx);
+  table_free(st);
+}
+
+int main() {
+  test1();
+  test2();
+  test3();
+  test4();
+  test5();
+  test6();
+  test7();
+}
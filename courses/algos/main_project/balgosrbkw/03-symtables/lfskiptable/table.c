@@ -0,0 +1,310 @@
+#include "table.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// Implementation based on a lock-free skip list
+// Same structure as skiptable: a sorted linked list at level 0, and express
+// lists at levels 1, 2, ... with nodes of random levels.
+// All links are modified with compare-and-swap (CAS), no thread ever takes a
+// lock.
+//
+// Logical deletion:
+// A node is deleted by marking its next links, from its top level down to
+// level 0. Marking the level 0 link is the actual deletion: the thread which
+// succeeds owns the delete.
+// A marked link can't be modified anymore, so no node can be inserted after
+// a deleted node.
+// Marked nodes are then physically unlinked (snipped) by any thread searching
+// through them.
+//
+// Insertion:
+// Search the predecessors and successors at every level, link the new node at
+// level 0 with a CAS (actual insertion), then at the upper levels one by one,
+// searching again when a CAS fails.
+//
+// Readers (get / contains / iterators) only follow links, skipping marked
+// nodes, they never write nor retry. They are lock-free, not wait-free:
+// concurrent insertions ahead of a reader can make its traversal arbitrarily
+// long.
+//
+// Deleted nodes are never freed while the table is alive: other threads may
+// still be reading them. (with lealloc_v0 fm_free doesn't free anyway)
+//
+// A mark is stored in a link by adding MARK to the node address (addresses
+// are < STD_FMEM_SIZE < MARK).
+// The search path is private to every call, it's kept in local arrays.
+//
+// Memory layout:
+// - st[0]: head node (no key, MAX_LEVEL levels)
+// - st[1]: number of entries
+// - st[2]: counter for the random levels
+//
+// Node layout: key, val, level, next[level]
+// table_free only walks the level 0 list: nodes already snipped from it are
+// never freed (fine with lealloc_v0, which never frees).
+
+#define MAX_LEVEL (20)
+#define MARK (1 << 30)
+
+static int_t is_marked(int_t link) { return link >= MARK; }
+
+static int_t unmarked(int_t link) { return link >= MARK ? link - MARK : link; }
+
+static int_t next_addr(int_t node, int_t level) { return node + 3 + level; }
+
+static int_t node_new(int_t key, int_t val, int_t level) {
+  int_t node = fm_alloc(3 + level);
+  std_fmemset(node, key);
+  std_fmemset(node + 1, val);
+  std_fmemset(node + 2, level);
+
+  int_t l = 0;
+  while (l < level) {
+    std_fmemset(next_addr(node, l), 0);
+    l = l + 1;
+  }
+  return node;
+}
+
+// Random level in [1, MAX_LEVEL]: 1 + number of trailing 1 bits of a hashed
+// counter
+// The counter is incremented atomically, every thread gets its own value
+static int_t random_level(int_t st) {
+  uint32_t h = (uint32_t)std_fmemxadd(st + 2, 1) * 2654435761u;
+  h = h ^ (h >> 16);
+  int_t level = 1;
+  while (level < MAX_LEVEL && h % 2) {
+    h = h / 2;
+    level = level + 1;
+  }
+  return level;
+}
+
+// Search for the last node with a key < key (preds) and the following node
+// (succs) at every level
+// Marked nodes met on the way are snipped out; if a snip fails, another
+// thread modified the link, and the search restarts from the head
+// Returns 1 if succs[0] has the key
+static int_t find(int_t st, int_t key, int_t *preds, int_t *succs) {
+  int_t restart = 1;
+  while (restart) {
+    restart = 0;
+    int_t pred = std_fmemget(st);
+    int_t level = MAX_LEVEL;
+
+    while (level > 0 && restart == 0) {
+      level = level - 1;
+      int_t curr = unmarked(std_fmemload(next_addr(pred, level)));
+
+      while (curr) {
+        int_t succ = std_fmemload(next_addr(curr, level));
+        while (is_marked(succ) && restart == 0) {
+          if (std_fmemcas(next_addr(pred, level), curr, unmarked(succ))) {
+            curr = unmarked(succ);
+            succ = curr ? std_fmemload(next_addr(curr, level)) : 0;
+          } else {
+            restart = 1;
+          }
+        }
+
+        if (restart || curr == 0 || std_fmemget(curr) >= key)
+          break;
+        pred = curr;
+        curr = unmarked(succ);
+      }
+
+      preds[level] = pred;
+      succs[level] = curr;
+    }
+  }
+
+  return succs[0] ? std_fmemget(succs[0]) == key : 0;
+}
+
+// Returns the first node with key >= key which is not deleted, or 0
+// Never writes nor restarts: the marked nodes are skipped, not snipped
+static int_t find_ceiling(int_t st, int_t key) {
+  int_t pred = std_fmemget(st);
+  int_t curr = 0;
+  int_t level = MAX_LEVEL;
+
+  while (level > 0) {
+    level = level - 1;
+    curr = unmarked(std_fmemload(next_addr(pred, level)));
+
+    while (curr) {
+      int_t succ = std_fmemload(next_addr(curr, level));
+      if (is_marked(succ)) {
+        curr = unmarked(succ);
+      } else if (std_fmemget(curr) < key) {
+        pred = curr;
+        curr = succ;
+      } else {
+        break;
+      }
+    }
+  }
+
+  return curr;
+}
+
+// Returns the node with key, or 0 if not found
+static int_t find_key(int_t st, int_t key) {
+  int_t node = find_ceiling(st, key);
+  return node ? (std_fmemget(node) == key ? node : 0) : 0;
+}
+
+// Returns the first node from node (included) which is not deleted, or 0
+static int_t skip_deleted(int_t node) {
+  while (node ? is_marked(std_fmemload(next_addr(node, 0))) : 0)
+    node = unmarked(std_fmemload(next_addr(node, 0)));
+  return node;
+}
+
+int_t table_new() {
+  int_t st = fm_alloc(3);
+  std_fmemset(st, node_new(0, 0, MAX_LEVEL));
+  std_fmemset(st + 1, 0);
+  std_fmemset(st + 2, 0);
+  return st;
+}
+
+void table_free(int_t st) {
+  int_t node = std_fmemget(st);
+  while (node) {
+    int_t next = unmarked(std_fmemget(next_addr(node, 0)));
+    fm_free(node);
+    node = next;
+  }
+  fm_free(st);
+}
+
+// Link the new node at level 0, then at the upper levels
+// Before linking at an upper level, the link of the new node is updated to the
+// current successor, with a CAS: if the node was marked meanwhile, it's being
+// deleted, and the remaining levels are not linked
+int_t table_put(int_t st, int_t key, int_t val) {
+  int_t preds[MAX_LEVEL];
+  int_t succs[MAX_LEVEL];
+  int_t node = 0;
+
+  while (1) {
+    if (find(st, key, preds, succs)) {
+      std_fmemstore(succs[0] + 1, val);
+      return 0;
+    }
+
+    if (node == 0)
+      node = node_new(key, 0, random_level(st));
+    std_fmemset(node + 1, val);
+
+    int_t level = std_fmemget(node + 2);
+    int_t l = 0;
+    while (l < level) {
+      std_fmemset(next_addr(node, l), succs[l]);
+      l = l + 1;
+    }
+
+    if (std_fmemcas(next_addr(preds[0], 0), succs[0], node))
+      break;
+  }
+
+  std_fmemxadd(st + 1, 1);
+
+  int_t level = std_fmemget(node + 2);
+  int_t l = 1;
+  while (l < level) {
+    int_t next = std_fmemload(next_addr(node, l));
+    if (is_marked(next))
+      return 1;
+    if (next == succs[l] || std_fmemcas(next_addr(node, l), next, succs[l])) {
+      if (std_fmemcas(next_addr(preds[l], l), succs[l], node))
+        l = l + 1;
+      else
+        find(st, key, preds, succs);
+    } else {
+      return 1;
+    }
+  }
+
+  return 1;
+}
+
+// Mark the links of the node from its top level down to level 0
+// The thread which marks level 0 owns the delete, and snips the node with a
+// last search
+int_t table_delete(int_t st, int_t key) {
+  int_t preds[MAX_LEVEL];
+  int_t succs[MAX_LEVEL];
+  if (find(st, key, preds, succs) == 0)
+    return 0;
+
+  int_t node = succs[0];
+  int_t l = std_fmemget(node + 2) - 1;
+  while (l > 0) {
+    int_t next = std_fmemload(next_addr(node, l));
+    if (is_marked(next) || std_fmemcas(next_addr(node, l), next, next + MARK))
+      l = l - 1;
+  }
+
+  while (1) {
+    int_t next = std_fmemload(next_addr(node, 0));
+    if (is_marked(next))
+      return 0;
+    if (std_fmemcas(next_addr(node, 0), next, next + MARK)) {
+      std_fmemxadd(st + 1, -1);
+      find(st, key, preds, succs);
+      return 1;
+    }
+  }
+}
+
+int_t table_get(int_t st, int_t key) {
+  int_t node = find_key(st, key);
+  panic_ifn(node);
+  return std_fmemload(node + 1);
+}
+
+int_t table_contains(int_t st, int_t key) { return find_key(st, key) != 0; }
+
+int_t table_size(int_t st) { return std_fmemload(st + 1); }
+
+// Iterator: current node
+// Walks through the level 0 list, which is sorted, skipping deleted nodes
+
+int_t table_it_new(int_t st) {
+  int_t it = fm_alloc(1);
+  int_t first = unmarked(std_fmemload(next_addr(std_fmemget(st), 0)));
+  std_fmemset(it, skip_deleted(first));
+  return it;
+}
+
+int_t table_it_new_from(int_t st, int_t lo) {
+  int_t it = fm_alloc(1);
+  std_fmemset(it, find_ceiling(st, lo));
+  return it;
+}
+
+void table_it_free(int_t it) { fm_free(it); }
+
+int_t table_it_is_end(int_t it) { return std_fmemget(it) == 0; }
+
+int_t table_it_get_key(int_t it) {
+  int_t node = std_fmemget(it);
+  panic_ifn(node);
+  return std_fmemget(node);
+}
+
+int_t table_it_get_val(int_t it) {
+  int_t node = std_fmemget(it);
+  panic_ifn(node);
+  return std_fmemload(node + 1);
+}
+
+void table_it_next(int_t it) {
+  int_t node = std_fmemget(it);
+  if (node) {
+    int_t next = unmarked(std_fmemload(next_addr(node, 0)));
+    std_fmemset(it, skip_deleted(next));
+  }
+}
@@ -0,0 +1,344 @@
+#include "table.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// Implementation based on hash table with linear probing (open addressing)
+// All entries are stored in flat parallel arrays, there is no allocation per
+// entry.
+// If the slot of a key is already used, try the next one, until finding an
+// empty slot.
+//
+// Robin Hood hashing:
+// Every entry keeps its probe sequence length (PSL): distance from its hash
+// slot + 1 (0 means empty slot)
+// When inserting, if the new entry is further from its slot than the entry in
+// place, they are swapped and the insertion continues with the old entry.
+// => PSL stay small and balanced, and a search can stop as soon as it finds an
+// entry with a PSL smaller than the current distance.
+//
+// Backward-shift deletion:
+// After removing an entry, the following entries of the cluster are moved
+// back by one slot, until an empty slot or an entry at its hash slot.
+// => no tombstones
+//
+// The capacity is a power of 2, the array is doubled when 3/4 full, and halved
+// when 1/8 full.
+// Operations are amortized O(1)
+//
+// Memory layout:
+// - st[0]: capacity
+// - st[1]: number of entries
+// - st[2]: hash shift (32 - log2(capacity))
+// - st[3]: slots array: keys[cap], vals[cap], psls[cap]
+
+#define MIN_CAP (8)
+#define BATCH_SIZE (16)
+
+static int_t st_cap(int_t st) { return std_fmemget(st); }
+
+static int_t key_addr(int_t st, int_t idx) { return std_fmemget(st + 3) + idx; }
+
+static int_t val_addr(int_t st, int_t idx) {
+  return std_fmemget(st + 3) + st_cap(st) + idx;
+}
+
+static int_t psl_addr(int_t st, int_t idx) {
+  return std_fmemget(st + 3) + 2 * st_cap(st) + idx;
+}
+
+// Performs hashing of integer to integer
+static int_t hash_fn(int_t x) { return x * 2654435761; }
+
+// Multiplicative hashing: the high bits of hash_fn are the best mixed
+// Keep the log2(capacity) high bits as the array index
+static int_t hash_key(int_t st, int_t x) {
+  uint32_t h = (uint32_t)hash_fn(x);
+  return (int_t)(h >> std_fmemget(st + 2));
+}
+
+static int_t next_idx(int_t st, int_t idx) {
+  idx = idx + 1;
+  return idx == st_cap(st) ? 0 : idx;
+}
+
+// Returns the slot index of `key`, or -1 if not found
+// Start searching at `idx`, which must be hash_key(st, key)
+static int_t find_key_at(int_t st, int_t key, int_t idx) {
+  int_t dist = 1;
+
+  while (std_fmemget(psl_addr(st, idx)) >= dist) {
+    if (std_fmemget(key_addr(st, idx)) == key)
+      return idx;
+    idx = next_idx(st, idx);
+    dist = dist + 1;
+  }
+
+  return -1;
+}
+
+static int_t find_key(int_t st, int_t key) {
+  return find_key_at(st, key, hash_key(st, key));
+}
+
+// Insert an entry which is not in the table
+// There must be at least one empty slot
+static void insert_new(int_t st, int_t key, int_t val) {
+  int_t idx = hash_key(st, key);
+  int_t psl = 1;
+
+  while (psl) {
+    int_t slot_psl = std_fmemget(psl_addr(st, idx));
+    if (slot_psl < psl) {
+      int_t slot_key = std_fmemget(key_addr(st, idx));
+      int_t slot_val = std_fmemget(val_addr(st, idx));
+      std_fmemset(key_addr(st, idx), key);
+      std_fmemset(val_addr(st, idx), val);
+      std_fmemset(psl_addr(st, idx), psl);
+      key = slot_key;
+      val = slot_val;
+      psl = slot_psl;
+    }
+
+    if (psl) {
+      idx = next_idx(st, idx);
+      psl = psl + 1;
+    }
+  }
+}
+
+static void slots_init(int_t st, int_t cap) {
+  int_t shift = 32;
+  int_t n = cap;
+  while (n > 1) {
+    n = n / 2;
+    shift = shift - 1;
+  }
+
+  int_t arr = fm_alloc(3 * cap);
+  std_fmemset(st, cap);
+  std_fmemset(st + 2, shift);
+  std_fmemset(st + 3, arr);
+
+  int_t i = 0;
+  while (i < cap) {
+    std_fmemset(arr + 2 * cap + i, 0);
+    i = i + 1;
+  }
+}
+
+// Move all entries to a new slots array with capacity `new_cap`
+static void table_resize(int_t st, int_t new_cap) {
+  int_t cap = st_cap(st);
+  int_t arr = std_fmemget(st + 3);
+  slots_init(st, new_cap);
+
+  int_t i = 0;
+  while (i < cap) {
+    if (std_fmemget(arr + 2 * cap + i))
+      insert_new(st, std_fmemget(arr + i), std_fmemget(arr + cap + i));
+    i = i + 1;
+  }
+
+  fm_free(arr);
+}
+
+int_t table_new() {
+  int_t st = fm_alloc(4);
+  std_fmemset(st + 1, 0);
+  slots_init(st, MIN_CAP);
+  return st;
+}
+
+// Size the table once for `n` entries, so that the insertions never resize
+// it, and insert them all with the batched put
+int_t table_from_array(int_t keys, int_t vals, int_t n) {
+  int_t cap = MIN_CAP;
+  while (4 * n > 3 * cap)
+    cap = 2 * cap;
+
+  int_t st = fm_alloc(4);
+  std_fmemset(st + 1, 0);
+  slots_init(st, cap);
+  table_put_many(st, keys, vals, n);
+  return st;
+}
+
+void table_free(int_t st) {
+  fm_free(std_fmemget(st + 3));
+  fm_free(st);
+}
+
+int_t table_put(int_t st, int_t key, int_t val) {
+  int_t idx = find_key(st, key);
+  if (idx != -1) {
+    std_fmemset(val_addr(st, idx), val);
+    return 0;
+  }
+
+  int_t cap = st_cap(st);
+  int_t size = std_fmemget(st + 1);
+  if (4 * (size + 1) > 3 * cap)
+    table_resize(st, 2 * cap);
+
+  insert_new(st, key, val);
+  std_fmemset(st + 1, size + 1);
+  return 1;
+}
+
+int_t table_delete(int_t st, int_t key) {
+  int_t idx = find_key(st, key);
+  if (idx == -1)
+    return 0;
+
+  int_t next = next_idx(st, idx);
+  int_t next_psl = std_fmemget(psl_addr(st, next));
+  while (next_psl > 1) {
+    std_fmemset(key_addr(st, idx), std_fmemget(key_addr(st, next)));
+    std_fmemset(val_addr(st, idx), std_fmemget(val_addr(st, next)));
+    std_fmemset(psl_addr(st, idx), next_psl - 1);
+    idx = next;
+    next = next_idx(st, idx);
+    next_psl = std_fmemget(psl_addr(st, next));
+  }
+  std_fmemset(psl_addr(st, idx), 0);
+
+  int_t cap = st_cap(st);
+  int_t size = std_fmemget(st + 1) - 1;
+  std_fmemset(st + 1, size);
+  if (cap > MIN_CAP && 8 * size <= cap)
+    table_resize(st, cap / 2);
+  return 1;
+}
+
+int_t table_get(int_t st, int_t key) {
+  int_t idx = find_key(st, key);
+  panic_ifn(idx != -1);
+  return std_fmemget(val_addr(st, idx));
+}
+
+int_t table_contains(int_t st, int_t key) { return find_key(st, key) != -1; }
+
+int_t table_size(int_t st) { return std_fmemget(st + 1); }
+
+// Batched lookups
+// The keys are processed by chunks of BATCH_SIZE, in 2 passes:
+// 1) hash all keys, and prefetch their slot
+// 2) search all keys
+// => the cache misses of the whole chunk overlap, instead of waiting for each
+// one before computing the next address
+// Write in out[i] the slot of keys[i], or -1 if not found
+static void batch_find(int_t st, int_t keys, int_t n, int_t out) {
+  int_t beg = 0;
+  while (beg < n) {
+    int_t end = beg + BATCH_SIZE < n ? beg + BATCH_SIZE : n;
+
+    int_t i = beg;
+    while (i < end) {
+      int_t idx = hash_key(st, std_fmemget(keys + i));
+      std_fmemprefetch(psl_addr(st, idx));
+      std_fmemprefetch(key_addr(st, idx));
+      std_fmemset(out + i, idx);
+      i = i + 1;
+    }
+
+    i = beg;
+    while (i < end) {
+      int_t idx = std_fmemget(out + i);
+      std_fmemset(out + i, find_key_at(st, std_fmemget(keys + i), idx));
+      i = i + 1;
+    }
+
+    beg = end;
+  }
+}
+
+void table_get_many(int_t st, int_t keys, int_t n, int_t out) {
+  batch_find(st, keys, n, out);
+  int_t i = 0;
+  while (i < n) {
+    int_t idx = std_fmemget(out + i);
+    panic_ifn(idx != -1);
+    std_fmemset(out + i, std_fmemget(val_addr(st, idx)));
+    i = i + 1;
+  }
+}
+
+void table_contains_many(int_t st, int_t keys, int_t n, int_t out) {
+  batch_find(st, keys, n, out);
+  int_t i = 0;
+  while (i < n) {
+    std_fmemset(out + i, std_fmemget(out + i) != -1);
+    i = i + 1;
+  }
+}
+
+// Puts can resize the table, so only the hashing and prefetching is done
+// ahead for the whole chunk
+int_t table_put_many(int_t st, int_t keys, int_t vals, int_t n) {
+  int_t res = 0;
+  int_t beg = 0;
+  while (beg < n) {
+    int_t end = beg + BATCH_SIZE < n ? beg + BATCH_SIZE : n;
+
+    int_t i = beg;
+    while (i < end) {
+      int_t idx = hash_key(st, std_fmemget(keys + i));
+      std_fmemprefetch(psl_addr(st, idx));
+      std_fmemprefetch(key_addr(st, idx));
+      i = i + 1;
+    }
+
+    i = beg;
+    while (i < end) {
+      res = res + table_put(st, std_fmemget(keys + i), std_fmemget(vals + i));
+      i = i + 1;
+    }
+
+    beg = end;
+  }
+
+  return res;
+}
+
+// Iterator: slot index, and table
+// Walks through the slots array, skipping the empty slots
+
+int_t table_it_new(int_t st) {
+  int_t it = fm_alloc(2);
+  std_fmemset(it, -1);
+  std_fmemset(it + 1, st);
+  table_it_next(it);
+  return it;
+}
+
+void table_it_free(int_t it) { fm_free(it); }
+
+int_t table_it_is_end(int_t it) {
+  int_t st = std_fmemget(it + 1);
+  return std_fmemget(it) == st_cap(st);
+}
+
+int_t table_it_get_key(int_t it) {
+  int_t st = std_fmemget(it + 1);
+  panic_ifn(table_it_is_end(it) == 0);
+  return std_fmemget(key_addr(st, std_fmemget(it)));
+}
+
+int_t table_it_get_val(int_t it) {
+  int_t st = std_fmemget(it + 1);
+  panic_ifn(table_it_is_end(it) == 0);
+  return std_fmemget(val_addr(st, std_fmemget(it)));
+}
+
+void table_it_next(int_t it) {
+  int_t idx = std_fmemget(it);
+  int_t st = std_fmemget(it + 1);
+  int_t cap = st_cap(st);
+
+  if (idx < cap) {
+    idx = idx + 1;
+    while (idx < cap ? std_fmemget(psl_addr(st, idx)) == 0 : 0)
+      idx = idx + 1;
+    std_fmemset(it, idx);
+  }
+}
@@ -0,0 +1,120 @@
+#include "table.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// Implementation based on a self-organizing linked list (move-to-front)
+// Same as lltable, but every key found by a search is moved to the front of
+// the list
+// => the most accessed keys stay near the front, for skewed accesses a search
+// stops after a few nodes
+// All operations are still linear in the worst case
+//
+// Node layout: key, val, next
+
+// Search the key, and move its node to the front of the list
+// Returns the node, or 0 if not found
+static int_t find_key(int_t st, int_t key) {
+  int_t prev_ptr = st;
+  int_t node = std_fmemget(st);
+
+  while (node) {
+    if (std_fmemget(node) == key) {
+      if (prev_ptr != st) {
+        std_fmemset(prev_ptr, std_fmemget(node + 2));
+        std_fmemset(node + 2, std_fmemget(st));
+        std_fmemset(st, node);
+      }
+      return node;
+    }
+
+    prev_ptr = node + 2;
+    node = std_fmemget(prev_ptr);
+  }
+
+  return 0;
+}
+
+int_t table_new() {
+  int_t st = fm_alloc(2);
+  std_fmemset(st, 0);
+  std_fmemset(st + 1, 0);
+  return st;
+}
+
+void table_free(int_t st) {
+  int_t node = std_fmemget(st);
+  while (node) {
+    int_t next = std_fmemget(node + 2);
+    fm_free(node);
+    node = next;
+  }
+
+  fm_free(st);
+}
+
+// New keys are inserted at the front
+int_t table_put(int_t st, int_t key, int_t val) {
+  int_t node = find_key(st, key);
+  if (node) {
+    std_fmemset(node + 1, val);
+    return 0;
+  }
+
+  node = fm_alloc(3);
+  std_fmemset(node, key);
+  std_fmemset(node + 1, val);
+  std_fmemset(node + 2, std_fmemget(st));
+  std_fmemset(st, node);
+  std_fmemset(st + 1, std_fmemget(st + 1) + 1);
+  return 1;
+}
+
+// After the search, the node is at the front
+int_t table_delete(int_t st, int_t key) {
+  int_t node = find_key(st, key);
+  if (node == 0)
+    return 0;
+
+  std_fmemset(st, std_fmemget(node + 2));
+  fm_free(node);
+  std_fmemset(st + 1, std_fmemget(st + 1) - 1);
+  return 1;
+}
+
+int_t table_get(int_t st, int_t key) {
+  int_t node = find_key(st, key);
+  panic_ifn(node);
+  return std_fmemget(node + 1);
+}
+
+int_t table_contains(int_t st, int_t key) { return find_key(st, key) != 0; }
+
+int_t table_size(int_t st) { return std_fmemget(st + 1); }
+
+int_t table_it_new(int_t st) {
+  int_t it = fm_alloc(1);
+  std_fmemset(it, std_fmemget(st));
+  return it;
+}
+
+void table_it_free(int_t it) { fm_free(it); }
+
+int_t table_it_is_end(int_t it) { return std_fmemget(it) == 0; }
+
+int_t table_it_get_key(int_t it) {
+  int_t node = std_fmemget(it);
+  panic_ifn(node);
+  return std_fmemget(node);
+}
+
+int_t table_it_get_val(int_t it) {
+  int_t node = std_fmemget(it);
+  panic_ifn(node);
+  return std_fmemget(node + 1);
+}
+
+void table_it_next(int_t it) {
+  int_t node = std_fmemget(it);
+  if (node)
+    std_fmemset(it, std_fmemget(node + 2));
+}
@@ -0,0 +1,388 @@
+#include "lealloc.h"
+#include "leio.h"
+#include "table.h"
+
+int_t cmp(int_t arr, int_t i, int_t j) {
+  return std_fmemget(arr + i) - std_fmemget(arr + j);
+}
+void swap(int_t arr, int_t i, int_t j) {
+  int_t vi = std_fmemget(arr + i);
+  std_fmemset(arr + i, std_fmemget(arr + j));
+  std_fmemset(arr + j, vi);
+}
+void sort(int_t arr, int_t len) {
+  int_t i = 0;
+  while (i < len) {
+
+    int_t j = i;
+    while (j > 0 && cmp(arr, j, j - 1) < 0) {
+      swap(arr, j, j - 1);
+      j = j - 1;
+    }
+
+    i = i + 1;
+  }
+}
+void print_arr(int_t arr, int_t len) {
+  sort(arr, len);
+  std_putc(91);
+
+  int_t i = 0;
+  while (i < len) {
+    print_int(std_fmemget(arr + i));
+    if (i + 1 < len) {
+      std_putc(44);
+      std_putc(32);
+    }
+    i = i + 1;
+  }
+
+  std_putc(93);
+  std_putc(10);
+}
+
+void sort2(int_t arr1, int arr2, int_t len) {
+  int_t i = 0;
+  while (i < len) {
+
+    int_t j = i;
+    while (j > 0 && cmp(arr1, j, j - 1) < 0) {
+      swap(arr1, j, j - 1);
+      swap(arr2, j, j - 1);
+      j = j - 1;
+    }
+
+    i = i + 1;
+  }
+}
+void print_arr2(int_t arr1, int arr2, int_t len) {
+  sort2(arr1, arr2, len);
+  std_putc(91);
+
+  int_t i = 0;
+  while (i < len) {
+    std_putc(40);
+    print_int(std_fmemget(arr1 + i));
+    std_putc(59);
+    print_int(std_fmemget(arr2 + i));
+    std_putc(41);
+    if (i + 1 < len) {
+      std_putc(44);
+      std_putc(32);
+    }
+    i = i + 1;
+  }
+
+  std_putc(93);
+  std_putc(10);
+}
+
+void print_keys(int_t st) {
+  int_t len = table_size(st);
+  int_t keys = fm_alloc(len);
+  int_t it = table_it_new(st);
+  int_t i = 0;
+
+  while (i < len) {
+    std_fmemset(keys + i, table_it_get_key(it));
+    table_it_next(it);
+    i = i + 1;
+  }
+
+  print_arr(keys, len);
+  table_it_free(it);
+  fm_free(keys);
+}
+
+void print_vals(int_t st) {
+  int_t len = table_size(st);
+  int_t vals = fm_alloc(len);
+  int_t it = table_it_new(st);
+  int_t i = 0;
+
+  while (i < len) {
+    std_fmemset(vals + i, table_it_get_val(it));
+    table_it_next(it);
+    i = i + 1;
+  }
+
+  print_arr(vals, len);
+  table_it_free(it);
+  fm_free(vals);
+}
+
+void print_table(int_t st) {
+  int_t len = table_size(st);
+  int_t keys = fm_alloc(len);
+  int_t vals = fm_alloc(len);
+  int_t it = table_it_new(st);
+  int_t i = 0;
+
+  while (i < len) {
+    std_fmemset(keys + i, table_it_get_key(it));
+    std_fmemset(vals + i, table_it_get_val(it));
+    table_it_next(it);
+    i = i + 1;
+  }
+
+  print_arr2(keys, vals, len);
+  table_it_free(it);
+  fm_free(keys);
+  fm_free(vals);
+}
+
+void test1() {
+  int_t st = table_new();
+  print_keys(st);
+  print_vals(st);
+  print_table(st);
+  table_free(st);
+}
+
+void test2() {
+  int_t st = table_new();
+  printnl_int(table_put(st, 3, 78));
+  printnl_int(table_put(st, 6, 4));
+  printnl_int(table_put(st, 2, 45));
+  printnl_int(table_put(st, 1, 27));
+  printnl_int(table_put(st, 2, 37));
+  printnl_int(table_put(st, 8, 44));
+
+  int_t i = 0;
+  while (i < 10) {
+    printnl_int(table_contains(st, i));
+    i = i + 1;
+  }
+
+  print_keys(st);
+  print_vals(st);
+  print_table(st);
+  table_free(st);
+}
+
+void test3() {
+  int_t st = table_new();
+  int_t i = 0;
+  while (i < 20) {
+    printnl_int(table_put(st, i, i * i));
+    i = i + 1;
+  }
+
+  i = 0;
+  while (i < 20) {
+    printnl_int(table_contains(st, i));
+    i = i + 1;
+  }
+  print_table(st);
+
+  i = 0;
+  while (i < 20) {
+    printnl_int(table_delete(st, i));
+    i = i + 1;
+  }
+
+  print_table(st);
+  table_free(st);
+}
+
+void test4() {
+  int_t st = table_new();
+  int_t i = -40;
+  while (i < 40) {
+    printnl_int(table_put(st, i, i * i));
+    i = i + 1;
+  }
+
+  i = -40;
+  while (i < 40) {
+    printnl_int(table_contains(st, i));
+    i = i + 1;
+  }
+  print_table(st);
+
+  i = -12;
+  while (i < 4) {
+    printnl_int(table_delete(st, i));
+    i = i + 1;
+  }
+
+  i = -40;
+  while (i < 40) {
+    printnl_int(table_contains(st, i));
+    i = i + 1;
+  }
+  print_table(st);
+
+  i = 4;
+  while (i < 28) {
+    printnl_int(table_put(st, i, 4 * i * i - 5));
+    i = i + 1;
+  }
+
+  i = -40;
+  while (i < 40) {
+    printnl_int(table_contains(st, i));
+    i = i + 1;
+  }
+  print_table(st);
+
+  i = -37;
+  while (i < 8) {
+    printnl_int(table_delete(st, i));
+    i = i + 1;
+  }
+
+  i = -40;
+  while (i < 40) {
+    printnl_int(table_contains(st, i));
+    i = i + 1;
+  }
+  print_table(st);
+
+  i = 16;
+  while (i < 39) {
+    printnl_int(table_put(st, i, -2 * i + 50));
+    i = i + 1;
+  }
+
+  i = -40;
+  while (i < 40) {
+    printnl_int(table_contains(st, i));
+    i = i + 1;
+  }
+  print_table(st);
+
+  table_free(st);
+}
+
+void test5() {
+  int_t st = table_new();
+  int_t i = 0;
+  while (i < 3000) {
+    table_put(st, (i * 7919) % 6007 - 3000, i);
+    i = i + 1;
+  }
+  printnl_int(table_size(st));
+
+  i = -3000;
+  while (i < 3000) {
+    printnl_int(table_delete(st, i));
+    i = i + 2;
+  }
+  printnl_int(table_size(st));
+
+  i = -3005;
+  while (i < 3005) {
+    printnl_int(table_contains(st, i));
+    if (table_contains(st, i))
+      printnl_int(table_get(st, i));
+    i = i + 1;
+  }
+  print_table(st);
+  table_free(st);
+}
+
+// Context of the threads of test6:
+// - ctx[0]: table
+// - ctx[1]: number of writers
+// - ctx[2]: number of keys per writer
+// - ctx[3]: number of wrong values seen by the readers
+
+// Writer w owns the keys w, w + nb_writers, w + 2 nb_writers, ...
+// It puts them with value 3k + 1, then updates them to 3k + 2
+// Meanwhile, it puts and deletes the negative keys -1 - k: the shards grow and
+// shrink while the readers search them
+void writer(int_t ctx, int_t w) {
+  int_t st = std_fmemget(ctx);
+  int_t nb_writers = std_fmemget(ctx + 1);
+  int_t n = std_fmemget(ctx + 2);
+  int_t i = 0;
+  while (i < n) {
+    int_t k = w + nb_writers * i;
+    table_put(st, k, 3 * k + 1);
+    table_put(st, -1 - k, k);
+    i = i + 1;
+  }
+
+  i = 0;
+  while (i < n) {
+    int_t k = w + nb_writers * i;
+    table_put(st, k, 3 * k + 2);
+    table_delete(st, -1 - k);
+    i = i + 1;
+  }
+}
+
+// A reader checks the value of every key it finds: it must be one written by
+// the writer of the key
+// Keys are never deleted while the readers run, so table_get can't fail after
+// table_contains
+void reader(int_t ctx) {
+  int_t st = std_fmemget(ctx);
+  int_t nb_keys = std_fmemget(ctx + 1) * std_fmemget(ctx + 2);
+  int_t wrong = 0;
+  int_t pass = 0;
+  while (pass < 3) {
+    int_t k = 0;
+    while (k < nb_keys) {
+      if (table_contains(st, k)) {
+        int_t val = table_get(st, k);
+        wrong = wrong + (val != 3 * k + 1 && val != 3 * k + 2);
+      }
+      table_contains(st, -1 - k);
+      k = k + 1;
+    }
+    pass = pass + 1;
+  }
+  std_fmemxadd(ctx + 3, wrong);
+}
+
+void writers_readers(int_t ctx, int_t idx) {
+  if (idx < std_fmemget(ctx + 1))
+    writer(ctx, idx);
+  else
+    reader(ctx);
+}
+
+// 4 writers on disjoint keys, and 2 readers
+void test6() {
+  int_t st = table_new();
+  int_t ctx = fm_alloc(4);
+  std_fmemset(ctx, st);
+  std_fmemset(ctx + 1, 4);
+  std_fmemset(ctx + 2, 2000);
+  std_fmemset(ctx + 3, 0);
+  std_parallel(6, writers_readers, ctx);
+  printnl_int(std_fmemget(ctx + 3));
+  printnl_int(table_size(st));
+
+  int_t wrong = 0;
+  int_t k = 0;
+  while (k < 8000) {
+    wrong = wrong + (table_get(st, k) != 3 * k + 2);
+    wrong = wrong + table_contains(st, -1 - k);
+    k = k + 1;
+  }
+  printnl_int(wrong);
+
+  int_t sum = 0;
+  int_t it = table_it_new(st);
+  while (table_it_is_end(it) == 0) {
+    sum = sum + table_it_get_val(it) - 3 * table_it_get_key(it);
+    table_it_next(it);
+  }
+  table_it_free(it);
+  printnl_int(sum);
+
+  fm_free(ctx);
+  table_free(st);
+}
+
+int main() {
+  test1();
+  test2();
+  test3();
+  test4();
+  test5();
+  test6();
+}
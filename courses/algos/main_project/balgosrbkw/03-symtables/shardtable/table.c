@@ -0,0 +1,390 @@
+#include "table.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// Implementation based on a sharded hash table, for concurrent use
+// The keys are split between NB_SHARDS independent hash tables (shards),
+// selected with the high bits of the hash.
+// Every shard is a linear probing hash table, with backward-shift deletion
+// (no tombstones), doubled when 3/4 full and halved when 1/8 full.
+//
+// Writers (put / delete) take the spinlock of their shard: writers of
+// different shards never wait for each other.
+//
+// Readers (get / contains) never take a lock, they use the seqlock of their
+// shard:
+// - every write to the slots is surrounded by 2 increments of the sequence
+// counter: it's odd while a write is in progress
+// - a reader reads the counter, searches the slots, and reads the counter
+// again: if it changed (or was odd), the read may be inconsistent, and it's
+// retried
+// A resize builds the new slots array on the side, and publishes it with a
+// single atomic write, readers still on the old array see a consistent
+// (unchanged) table.
+// Readers may still read an old array after it's freed: this requires an
+// allocator which doesn't reuse memory (lealloc_v0, the only one safe to use
+// from several threads).
+//
+// Memory layout: NB_SHARDS shards of SHARD_WORDS words (one cache line each,
+// st is aligned on a line)
+// - st[4]: allocated block, st is the first line start in it (free word of
+// shard 0)
+// Shard:
+// - shard[0]: spinlock (1 if taken)
+// - shard[1]: sequence counter
+// - shard[2]: number of entries
+// - shard[3]: slots array
+// Slots array:
+// - arr[0]: capacity
+// - arr[1]: hash shift (32 - log2(capacity))
+// - arr[2..]: keys[cap], vals[cap], used[cap]
+
+#define SHARD_BITS (4)
+#define NB_SHARDS (16)
+#define SHARD_WORDS (STD_FMEM_LINE_WORDS)
+#define MIN_CAP (8)
+#define SPIN_LIMIT (64)
+
+// Performs hashing of integer to integer
+static uint32_t hash_fn(int_t x) { return (uint32_t)x * 2654435761u; }
+
+// The SHARD_BITS high bits of the hash select the shard
+static int_t shard_addr(int_t st, int_t key) {
+  return st + SHARD_WORDS * (int_t)(hash_fn(key) >> (32 - SHARD_BITS));
+}
+
+static int_t arr_cap(int_t arr) { return std_fmemget(arr); }
+
+static int_t key_addr(int_t arr, int_t idx) { return arr + 2 + idx; }
+
+static int_t val_addr(int_t arr, int_t idx) {
+  return arr + 2 + arr_cap(arr) + idx;
+}
+
+static int_t used_addr(int_t arr, int_t idx) {
+  return arr + 2 + 2 * arr_cap(arr) + idx;
+}
+
+// The next log2(capacity) bits of the hash are the slot index
+static int_t slot_idx(int_t arr, int_t key) {
+  uint32_t h = hash_fn(key) << SHARD_BITS;
+  return (int_t)(h >> std_fmemget(arr + 1));
+}
+
+static int_t next_idx(int_t arr, int_t idx) {
+  idx = idx + 1;
+  return idx == arr_cap(arr) ? 0 : idx;
+}
+
+static int_t slots_new(int_t cap) {
+  int_t shift = 32;
+  int_t n = cap;
+  while (n > 1) {
+    n = n / 2;
+    shift = shift - 1;
+  }
+
+  int_t arr = fm_alloc(2 + 3 * cap);
+  std_fmemset(arr, cap);
+  std_fmemset(arr + 1, shift);
+
+  int_t i = 0;
+  while (i < cap) {
+    std_fmemset(used_addr(arr, i), 0);
+    i = i + 1;
+  }
+  return arr;
+}
+
+// Returns the slot index of `key`, or -1 if not found
+// Never does more than cap probes, even if the slots are being modified by a
+// writer
+static int_t find_slot(int_t arr, int_t key) {
+  int_t cap = arr_cap(arr);
+  int_t idx = slot_idx(arr, key);
+  int_t probes = 0;
+
+  while (probes < cap ? std_fmemget(used_addr(arr, idx)) : 0) {
+    if (std_fmemget(key_addr(arr, idx)) == key)
+      return idx;
+    idx = next_idx(arr, idx);
+    probes = probes + 1;
+  }
+
+  return -1;
+}
+
+// Insert an entry which is not in the slots array
+// There must be at least one empty slot
+static void insert_new(int_t arr, int_t key, int_t val) {
+  int_t idx = slot_idx(arr, key);
+  while (std_fmemget(used_addr(arr, idx)))
+    idx = next_idx(arr, idx);
+
+  std_fmemset(key_addr(arr, idx), key);
+  std_fmemset(val_addr(arr, idx), val);
+  std_fmemset(used_addr(arr, idx), 1);
+}
+
+// Returns 1 if h is in the cyclic range ]i, j]
+static int_t in_range(int_t i, int_t h, int_t j) {
+  return i <= j ? (h > i && h <= j) : (h > i || h <= j);
+}
+
+// Remove the entry at slot idx
+// The following entries of the cluster are moved back into the hole, unless
+// their hash slot is between the hole and their slot
+static void remove_at(int_t arr, int_t idx) {
+  int_t next = next_idx(arr, idx);
+  while (std_fmemget(used_addr(arr, next))) {
+    int_t h = slot_idx(arr, std_fmemget(key_addr(arr, next)));
+    if (in_range(idx, h, next) == 0) {
+      std_fmemset(key_addr(arr, idx), std_fmemget(key_addr(arr, next)));
+      std_fmemset(val_addr(arr, idx), std_fmemget(val_addr(arr, next)));
+      idx = next;
+    }
+    next = next_idx(arr, next);
+  }
+
+  std_fmemset(used_addr(arr, idx), 0);
+}
+
+// Wait for `spins` iterations of a spin loop
+// After SPIN_LIMIT iterations, the thread we're waiting for may not be
+// running, let it run
+static int_t spin_wait(int_t spins) {
+  if (spins < SPIN_LIMIT)
+    return spins + 1;
+  std_yield();
+  return 0;
+}
+
+static void shard_lock(int_t shard) {
+  int_t spins = 0;
+  while (std_fmemcas(shard, 0, 1) == 0) {
+    // Wait with plain reads, without writing to the lock cache line
+    while (std_fmemload(shard))
+      spins = spin_wait(spins);
+  }
+}
+
+static void shard_unlock(int_t shard) { std_fmemstore(shard, 0); }
+
+static void write_begin(int_t shard) {
+  std_fmemxadd(shard + 1, 1);
+  std_fmemfence();
+}
+
+static void write_end(int_t shard) {
+  std_fmemfence();
+  std_fmemxadd(shard + 1, 1);
+}
+
+// Wait until no write is in progress, and returns the sequence counter
+static int_t read_begin(int_t shard) {
+  int_t spins = 0;
+  int_t seq = std_fmemload(shard + 1);
+  while (seq % 2) {
+    spins = spin_wait(spins);
+    seq = std_fmemload(shard + 1);
+  }
+  return seq;
+}
+
+// Returns 1 if a write happened since read_begin returned seq
+static int_t read_retry(int_t shard, int_t seq) {
+  std_fmemfence();
+  return std_fmemload(shard + 1) != seq;
+}
+
+// Move all entries to a new slots array with capacity `new_cap`
+// The shard lock must be taken
+// The old array is not modified, so readers don't need to retry
+static void shard_resize(int_t shard, int_t new_cap) {
+  int_t arr = std_fmemget(shard + 3);
+  int_t cap = arr_cap(arr);
+  int_t new_arr = slots_new(new_cap);
+
+  int_t i = 0;
+  while (i < cap) {
+    if (std_fmemget(used_addr(arr, i)))
+      insert_new(new_arr, std_fmemget(key_addr(arr, i)),
+                 std_fmemget(val_addr(arr, i)));
+    i = i + 1;
+  }
+
+  std_fmemstore(shard + 3, new_arr);
+  fm_free(arr);
+}
+
+int_t table_new() {
+  int_t block = fm_alloc((NB_SHARDS + 1) * SHARD_WORDS - 1);
+  int_t st = (block + SHARD_WORDS - 1) / SHARD_WORDS * SHARD_WORDS;
+  std_fmemset(st + 4, block);
+  int_t i = 0;
+  while (i < NB_SHARDS) {
+    int_t shard = st + SHARD_WORDS * i;
+    std_fmemset(shard, 0);
+    std_fmemset(shard + 1, 0);
+    std_fmemset(shard + 2, 0);
+    std_fmemset(shard + 3, slots_new(MIN_CAP));
+    i = i + 1;
+  }
+  return st;
+}
+
+void table_free(int_t st) {
+  int_t i = 0;
+  while (i < NB_SHARDS) {
+    fm_free(std_fmemget(st + SHARD_WORDS * i + 3));
+    i = i + 1;
+  }
+  fm_free(std_fmemget(st + 4));
+}
+
+int_t table_put(int_t st, int_t key, int_t val) {
+  int_t shard = shard_addr(st, key);
+  shard_lock(shard);
+
+  int_t arr = std_fmemget(shard + 3);
+  int_t idx = find_slot(arr, key);
+  if (idx != -1) {
+    write_begin(shard);
+    std_fmemset(val_addr(arr, idx), val);
+    write_end(shard);
+    shard_unlock(shard);
+    return 0;
+  }
+
+  int_t size = std_fmemget(shard + 2);
+  if (4 * (size + 1) > 3 * arr_cap(arr)) {
+    shard_resize(shard, 2 * arr_cap(arr));
+    arr = std_fmemget(shard + 3);
+  }
+
+  write_begin(shard);
+  insert_new(arr, key, val);
+  write_end(shard);
+  std_fmemstore(shard + 2, size + 1);
+  shard_unlock(shard);
+  return 1;
+}
+
+int_t table_delete(int_t st, int_t key) {
+  int_t shard = shard_addr(st, key);
+  shard_lock(shard);
+
+  int_t arr = std_fmemget(shard + 3);
+  int_t idx = find_slot(arr, key);
+  if (idx == -1) {
+    shard_unlock(shard);
+    return 0;
+  }
+
+  write_begin(shard);
+  remove_at(arr, idx);
+  write_end(shard);
+
+  int_t size = std_fmemget(shard + 2) - 1;
+  std_fmemstore(shard + 2, size);
+  int_t cap = arr_cap(arr);
+  if (cap > MIN_CAP && 8 * size <= cap)
+    shard_resize(shard, cap / 2);
+
+  shard_unlock(shard);
+  return 1;
+}
+
+int_t table_get(int_t st, int_t key) {
+  int_t shard = shard_addr(st, key);
+  int_t idx = -1;
+  int_t val = 0;
+  int_t retry = 1;
+
+  while (retry) {
+    int_t seq = read_begin(shard);
+    int_t arr = std_fmemload(shard + 3);
+    idx = find_slot(arr, key);
+    if (idx != -1)
+      val = std_fmemget(val_addr(arr, idx));
+    retry = read_retry(shard, seq);
+  }
+
+  panic_ifn(idx != -1);
+  return val;
+}
+
+int_t table_contains(int_t st, int_t key) {
+  int_t shard = shard_addr(st, key);
+  int_t idx = -1;
+  int_t retry = 1;
+
+  while (retry) {
+    int_t seq = read_begin(shard);
+    idx = find_slot(std_fmemload(shard + 3), key);
+    retry = read_retry(shard, seq);
+  }
+
+  return idx != -1;
+}
+
+int_t table_size(int_t st) {
+  int_t res = 0;
+  int_t i = 0;
+  while (i < NB_SHARDS) {
+    res = res + std_fmemload(st + SHARD_WORDS * i + 2);
+    i = i + 1;
+  }
+  return res;
+}
+
+// Iterator: table, shard index, slot index
+// Walks through the slots arrays of all shards, skipping the empty slots
+
+int_t table_it_new(int_t st) {
+  int_t it = fm_alloc(3);
+  std_fmemset(it, st);
+  std_fmemset(it + 1, 0);
+  std_fmemset(it + 2, -1);
+  table_it_next(it);
+  return it;
+}
+
+void table_it_free(int_t it) { fm_free(it); }
+
+int_t table_it_is_end(int_t it) { return std_fmemget(it + 1) == NB_SHARDS; }
+
+static int_t it_arr(int_t it) {
+  return std_fmemget(std_fmemget(it) + SHARD_WORDS * std_fmemget(it + 1) + 3);
+}
+
+int_t table_it_get_key(int_t it) {
+  panic_ifn(table_it_is_end(it) == 0);
+  return std_fmemget(key_addr(it_arr(it), std_fmemget(it + 2)));
+}
+
+int_t table_it_get_val(int_t it) {
+  panic_ifn(table_it_is_end(it) == 0);
+  return std_fmemget(val_addr(it_arr(it), std_fmemget(it + 2)));
+}
+
+void table_it_next(int_t it) {
+  int_t shard_i = std_fmemget(it + 1);
+  int_t idx = std_fmemget(it + 2);
+
+  while (shard_i < NB_SHARDS) {
+    int_t arr = it_arr(it);
+    idx = idx + 1;
+    while (idx < arr_cap(arr) ? std_fmemget(used_addr(arr, idx)) == 0 : 0)
+      idx = idx + 1;
+
+    if (idx < arr_cap(arr)) {
+      std_fmemset(it + 2, idx);
+      return;
+    }
+
+    shard_i = shard_i + 1;
+    idx = -1;
+    std_fmemset(it + 1, shard_i);
+  }
+}
@@ -0,0 +1,226 @@
+#include "table.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// Implementation based on a skip list
+// All entries are in a sorted linked list (level 0).
+// Every node is also in the lists of levels 1, 2, ... up to its own level,
+// chosen at random: a node has a level > l with probability 1/2^l
+// => every level skips about half of the nodes of the level below
+//
+// Search: start at the highest level of the head, move forward while the next
+// key is < key, then go down one level, until level 0
+// All operations are O(log(n)) in average, whatever the insertion order.
+//
+// Memory layout:
+// - st[0]: head node (no key, MAX_LEVEL levels)
+// - st[1]: number of entries
+// - st[2]: number of levels in use
+// - st[3]: counter for the random levels
+// - st[4..4+MAX_LEVEL[: search path: last node before key at every level
+//
+// Node layout: key, val, level, next[level]
+
+#define MAX_LEVEL (20)
+
+static int_t node_new(int_t key, int_t val, int_t level) {
+  int_t node = fm_alloc(3 + level);
+  std_fmemset(node, key);
+  std_fmemset(node + 1, val);
+  std_fmemset(node + 2, level);
+
+  int_t l = 0;
+  while (l < level) {
+    std_fmemset(node + 3 + l, 0);
+    l = l + 1;
+  }
+  return node;
+}
+
+static int_t next_addr(int_t node, int_t level) { return node + 3 + level; }
+
+static int_t path_addr(int_t st, int_t level) { return st + 4 + level; }
+
+// Random level in [1, MAX_LEVEL]: 1 + number of trailing 1 bits of a hashed
+// counter
+static int_t random_level(int_t st) {
+  int_t count = std_fmemget(st + 3);
+  std_fmemset(st + 3, count + 1);
+
+  uint32_t h = (uint32_t)count * 2654435761u;
+  h = h ^ (h >> 16);
+  int_t level = 1;
+  while (level < MAX_LEVEL && h % 2) {
+    h = h / 2;
+    level = level + 1;
+  }
+  return level;
+}
+
+// Search for the last node with a key < key at every level, and store them in
+// the search path
+// Returns the node following it at level 0 (first node with key >= key), or 0
+static int_t find_path(int_t st, int_t key) {
+  int_t node = std_fmemget(st);
+  int_t level = std_fmemget(st + 2);
+
+  while (level > 0) {
+    level = level - 1;
+    int_t next = std_fmemget(next_addr(node, level));
+    while (next ? std_fmemget(next) < key : 0) {
+      node = next;
+      next = std_fmemget(next_addr(node, level));
+    }
+    std_fmemset(path_addr(st, level), node);
+  }
+
+  return std_fmemget(next_addr(node, 0));
+}
+
+// Returns the first node with key >= key, or 0
+// Same as find_path, without storing the path
+// There is always at least one level in use, so next is the level 0 node
+static int_t find_ceiling(int_t st, int_t key) {
+  int_t node = std_fmemget(st);
+  int_t level = std_fmemget(st + 2);
+  int_t next = 0;
+
+  while (level > 0) {
+    level = level - 1;
+    next = std_fmemget(next_addr(node, level));
+    while (next ? std_fmemget(next) < key : 0) {
+      node = next;
+      next = std_fmemget(next_addr(node, level));
+    }
+  }
+
+  return next;
+}
+
+// Returns the node with key, or 0 if not found
+static int_t find_key(int_t st, int_t key) {
+  int_t node = find_ceiling(st, key);
+  return node ? (std_fmemget(node) == key ? node : 0) : 0;
+}
+
+int_t table_new() {
+  int_t st = fm_alloc(4 + MAX_LEVEL);
+  std_fmemset(st, node_new(0, 0, MAX_LEVEL));
+  std_fmemset(st + 1, 0);
+  std_fmemset(st + 2, 1);
+  std_fmemset(st + 3, 0);
+  return st;
+}
+
+void table_free(int_t st) {
+  int_t node = std_fmemget(st);
+  while (node) {
+    int_t next = std_fmemget(next_addr(node, 0));
+    fm_free(node);
+    node = next;
+  }
+  fm_free(st);
+}
+
+// Search the path, and insert the new node after the path nodes, at all its
+// levels
+int_t table_put(int_t st, int_t key, int_t val) {
+  int_t node = find_path(st, key);
+  if (node ? std_fmemget(node) == key : 0) {
+    std_fmemset(node + 1, val);
+    return 0;
+  }
+
+  int_t level = random_level(st);
+  int_t used = std_fmemget(st + 2);
+  while (used < level) {
+    std_fmemset(path_addr(st, used), std_fmemget(st));
+    used = used + 1;
+  }
+  std_fmemset(st + 2, used);
+
+  node = node_new(key, val, level);
+  int_t l = 0;
+  while (l < level) {
+    int_t prev = std_fmemget(path_addr(st, l));
+    std_fmemset(next_addr(node, l), std_fmemget(next_addr(prev, l)));
+    std_fmemset(next_addr(prev, l), node);
+    l = l + 1;
+  }
+
+  std_fmemset(st + 1, std_fmemget(st + 1) + 1);
+  return 1;
+}
+
+// Search the path, and unlink the node from all its levels
+int_t table_delete(int_t st, int_t key) {
+  int_t node = find_path(st, key);
+  if (node ? std_fmemget(node) != key : 1)
+    return 0;
+
+  int_t level = std_fmemget(node + 2);
+  int_t l = 0;
+  while (l < level) {
+    int_t prev = std_fmemget(path_addr(st, l));
+    std_fmemset(next_addr(prev, l), std_fmemget(next_addr(node, l)));
+    l = l + 1;
+  }
+  fm_free(node);
+
+  // Drop the empty top levels
+  int_t head = std_fmemget(st);
+  int_t used = std_fmemget(st + 2);
+  while (used > 1 && std_fmemget(next_addr(head, used - 1)) == 0)
+    used = used - 1;
+  std_fmemset(st + 2, used);
+
+  std_fmemset(st + 1, std_fmemget(st + 1) - 1);
+  return 1;
+}
+
+int_t table_get(int_t st, int_t key) {
+  int_t node = find_key(st, key);
+  panic_ifn(node);
+  return std_fmemget(node + 1);
+}
+
+int_t table_contains(int_t st, int_t key) { return find_key(st, key) != 0; }
+
+int_t table_size(int_t st) { return std_fmemget(st + 1); }
+
+// Iterator: current node
+// Walks through the level 0 list, which is sorted
+
+int_t table_it_new(int_t st) {
+  int_t it = fm_alloc(1);
+  std_fmemset(it, std_fmemget(next_addr(std_fmemget(st), 0)));
+  return it;
+}
+
+int_t table_it_new_from(int_t st, int_t lo) {
+  int_t it = fm_alloc(1);
+  std_fmemset(it, find_ceiling(st, lo));
+  return it;
+}
+
+void table_it_free(int_t it) { fm_free(it); }
+
+int_t table_it_is_end(int_t it) { return std_fmemget(it) == 0; }
+
+int_t table_it_get_key(int_t it) {
+  int_t node = std_fmemget(it);
+  panic_ifn(node);
+  return std_fmemget(node);
+}
+
+int_t table_it_get_val(int_t it) {
+  int_t node = std_fmemget(it);
+  panic_ifn(node);
+  return std_fmemget(node + 1);
+}
+
+void table_it_next(int_t it) {
+  int_t node = std_fmemget(it);
+  if (node)
+    std_fmemset(it, std_fmemget(next_addr(node, 0)));
+}
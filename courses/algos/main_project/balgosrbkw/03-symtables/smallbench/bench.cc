@@ -0,0 +1,100 @@
+// Benchmark of the symbols table implementations on small tables
+// The same driver is linked against every implementation of table.h
+//
+// n entries (keys 0..n-1 in random order), then 10^6 operations:
+// - uniform: get of a uniformly random key
+// - skewed: get, 90% of the time of one of the first n/8 keys
+// - churn: 50% get, 25% put, 25% delete on keys in [0, 2n[
+
+extern "C" {
+#include "table.h"
+}
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+using clk = std::chrono::steady_clock;
+
+const int NB_OPS = 1000000;
+
+void report(const char *name, int n, clk::time_point start) {
+  double secs = std::chrono::duration<double>(clk::now() - start).count();
+  std::cout << name << "\t" << n << "\t" << NB_OPS << "\t" << secs * 1e3
+            << "\t" << NB_OPS / secs / 1e6 << std::endl;
+}
+
+int_t fill(int n, std::mt19937 &rng) {
+  std::vector<int> keys(n);
+  for (int i = 0; i < n; ++i)
+    keys[i] = i;
+  std::shuffle(keys.begin(), keys.end(), rng);
+
+  int_t st = table_new();
+  for (int i = 0; i < n; ++i)
+    table_put(st, keys[i], i);
+  return st;
+}
+
+void bench_uniform(int n) {
+  std::mt19937 rng(n);
+  std::uniform_int_distribution<std::int32_t> key(0, n - 1);
+  int_t st = fill(n, rng);
+
+  auto start = clk::now();
+  for (int i = 0; i < NB_OPS; ++i)
+    table_get(st, key(rng));
+  report("uniform", n, start);
+  table_free(st);
+}
+
+void bench_skewed(int n) {
+  std::mt19937 rng(n);
+  std::uniform_int_distribution<std::int32_t> key(0, n - 1);
+  std::uniform_int_distribution<std::int32_t> hot(0, std::max(n / 8, 1) - 1);
+  std::uniform_int_distribution<int> pick(0, 9);
+  int_t st = fill(n, rng);
+
+  auto start = clk::now();
+  for (int i = 0; i < NB_OPS; ++i)
+    table_get(st, pick(rng) < 9 ? hot(rng) : key(rng));
+  report("skewed", n, start);
+  table_free(st);
+}
+
+void bench_churn(int n) {
+  std::mt19937 rng(n);
+  std::uniform_int_distribution<std::int32_t> key(0, 2 * n - 1);
+  std::uniform_int_distribution<int> op(0, 3);
+  int_t st = fill(n, rng);
+
+  auto start = clk::now();
+  for (int i = 0; i < NB_OPS; ++i) {
+    int_t k = key(rng);
+    int r = op(rng);
+    if (r < 2)
+      table_contains(st, k);
+    else if (r == 2)
+      table_put(st, k, i);
+    else
+      table_delete(st, k);
+  }
+  report("churn", n, start);
+  table_free(st);
+}
+
+} // namespace
+
+int main() {
+  std::cout << "workload\tn\tops\ttime_ms\tMops/s" << std::endl;
+  for (int n = 4; n <= 256; n *= 2) {
+    bench_uniform(n);
+    bench_skewed(n);
+    bench_churn(n);
+  }
+}
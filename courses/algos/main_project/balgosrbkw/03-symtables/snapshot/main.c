@@ -0,0 +1,195 @@
+#include "lealloc.h"
+#include "leio.h"
+#include "snapshot.h"
+#include "table.h"
+
+void print_snap(int_t snap) {
+  int_t len = snap_size(snap);
+  std_putc(91);
+
+  int_t i = 0;
+  while (i < len) {
+    std_putc(40);
+    print_int(snap_key_at(snap, i));
+    std_putc(59);
+    print_int(snap_val_at(snap, i));
+    std_putc(41);
+    if (i + 1 < len) {
+      std_putc(44);
+      std_putc(32);
+    }
+    i = i + 1;
+  }
+
+  std_putc(93);
+  std_putc(10);
+}
+
+void test1() {
+  int_t st = table_new();
+  int_t snap = snap_new(st);
+  printnl_int(snap_size(snap));
+  printnl_int(snap_len(snap));
+  printnl_int(snap_contains(snap, 0));
+  print_snap(snap);
+  snap_free(snap);
+  table_free(st);
+}
+
+void test2() {
+  int_t st = table_new();
+  table_put(st, 3, 78);
+  table_put(st, 6, 4);
+  table_put(st, 2, 45);
+  table_put(st, 1, 27);
+  table_put(st, 2, 37);
+  table_put(st, 8, 44);
+
+  int_t snap = snap_new(st);
+  table_free(st);
+
+  printnl_int(snap_size(snap));
+  printnl_int(snap_len(snap));
+  int_t i = 0;
+  while (i < 10) {
+    printnl_int(snap_contains(snap, i));
+    if (snap_contains(snap, i))
+      printnl_int(snap_get(snap, i));
+    i = i + 1;
+  }
+  print_snap(snap);
+  snap_free(snap);
+}
+
+void test3() {
+  int_t st = table_new();
+  int_t i = 0;
+  while (i < 500) {
+    table_put(st, (i * 7919) % 1009 - 500, i);
+    i = i + 1;
+  }
+  i = -500;
+  while (i < 500) {
+    table_delete(st, i);
+    i = i + 3;
+  }
+
+  int_t snap = snap_new(st);
+  table_free(st);
+  printnl_int(snap_size(snap));
+  print_snap(snap);
+
+  // The image has no pointers: a copy can be queried in place
+  int_t len = snap_len(snap);
+  int_t copy = fm_alloc(len);
+  std_fmemcpy(copy, snap, len);
+  snap_free(snap);
+
+  i = -510;
+  while (i < 510) {
+    printnl_int(snap_contains(copy, i));
+    if (snap_contains(copy, i))
+      printnl_int(snap_get(copy, i));
+    i = i + 1;
+  }
+  fm_free(copy);
+}
+
+// Write an image to a bytes array, and read it back
+void test4() {
+  int_t st = table_new();
+  int_t i = 0;
+  while (i < 20) {
+    table_put(st, 13 * i - 100, i * i - 50);
+    i = i + 1;
+  }
+  int_t snap = snap_new(st);
+  table_free(st);
+
+  int_t buf = fm_alloc(4 * snap_len(snap) + 1);
+  int_t nb = snap_write_bytes(snap, buf);
+  printnl_int(nb);
+
+  // Magic number, size, first key, least significant byte first
+  i = 0;
+  while (i < 12) {
+    print_int(std_fmemget(buf + i));
+    std_putc(32);
+    i = i + 1;
+  }
+  printnl();
+
+  int_t copy = snap_read_bytes(buf, nb);
+  printnl_int(copy != 0);
+  print_snap(copy);
+  int_t diffs = 0;
+  i = -110;
+  while (i < 160) {
+    diffs = diffs + (snap_contains(copy, i) != snap_contains(snap, i));
+    if (snap_contains(copy, i))
+      diffs = diffs + (snap_get(copy, i) != snap_get(snap, i));
+    i = i + 1;
+  }
+  printnl_int(diffs);
+  snap_free(copy);
+
+  // Invalid images: bad magic number, truncated, trailing byte, unsorted
+  // keys, size too big, size bigger than the bytes left
+  std_fmemset(buf, 81);
+  printnl_int(snap_read_bytes(buf, nb));
+  std_fmemset(buf, 80);
+  printnl_int(snap_read_bytes(buf, nb - 1));
+  std_fmemset(buf + nb, 0);
+  printnl_int(snap_read_bytes(buf, nb + 1));
+  std_fmemset(buf + 12, 0);
+  printnl_int(snap_read_bytes(buf, nb));
+  std_fmemset(buf + 12, 169);
+  std_fmemset(buf + 7, 127);
+  printnl_int(snap_read_bytes(buf, nb));
+  std_fmemset(buf + 7, 0);
+  // 1000 entries announced: rejected before allocating the image, only the
+  // stream (3 words) is allocated
+  std_fmemset(buf + 4, 232);
+  std_fmemset(buf + 5, 3);
+  int_t top = std_fmemget(0);
+  printnl_int(snap_read_bytes(buf, nb));
+  printnl_int(std_fmemget(0) - top - 3);
+  std_fmemset(buf + 4, 20);
+  std_fmemset(buf + 5, 0);
+
+  copy = snap_read_bytes(buf, nb);
+  printnl_int(snap_size(copy));
+  snap_free(copy);
+  snap_free(snap);
+  fm_free(buf);
+
+  // Empty snapshot
+  st = table_new();
+  snap = snap_new(st);
+  buf = fm_alloc(8);
+  printnl_int(snap_write_bytes(snap, buf));
+  copy = snap_read_bytes(buf, 8);
+  printnl_int(snap_size(copy));
+  printnl_int(snap_read_bytes(buf, 0));
+  snap_free(copy);
+  snap_free(snap);
+  table_free(st);
+  fm_free(buf);
+}
+
+// Read an image from the standard input, and write it back to the standard
+// output
+void test5() {
+  int_t snap = snap_read();
+  print_snap(snap);
+  snap_write(snap);
+  snap_free(snap);
+}
+
+int main() {
+  test1();
+  test2();
+  test3();
+  test4();
+  test5();
+}
@@ -0,0 +1,303 @@
+#include "snapshot.h"
+#include "lealloc.h"
+#include "ledebug.h"
+#include "table.h"
+
+// Image layout:
+// - snap[0]: magic number
+// - snap[1]: number of entries n
+// - snap[2..2+n[: keys, sorted in increasing order
+// - snap[2+n..2+2n[: values
+//
+// A lookup is a binary search on the keys: O(log(n)), no allocation.
+// Loading an image is reading its words, nothing is rebuilt.
+//
+// Written as 4 bytes per word, least significant byte first.
+
+#define SNAP_MAGIC (0x534e4150)
+#define READ_CHUNK (1024)
+
+static int_t keys_addr(int_t snap) { return snap + 2; }
+
+static int_t vals_addr(int_t snap) { return snap + 2 + snap_size(snap); }
+
+// Merge the sorted runs [lo, mid[ and [mid, hi[ of keys/vals into
+// out_keys/out_vals
+static void merge(int_t keys, int_t vals, int_t out_keys, int_t out_vals,
+                  int_t lo, int_t mid, int_t hi) {
+  int_t i = lo;
+  int_t j = mid;
+  int_t k = lo;
+  while (k < hi) {
+    int_t from_left =
+        j == hi ? 1
+                : (i < mid ? std_fmemget(keys + i) < std_fmemget(keys + j) : 0);
+    int_t src = from_left ? i : j;
+    std_fmemset(out_keys + k, std_fmemget(keys + src));
+    std_fmemset(out_vals + k, std_fmemget(vals + src));
+    if (from_left)
+      i = i + 1;
+    else
+      j = j + 1;
+    k = k + 1;
+  }
+}
+
+// Bottom-up merge sort of the entries of the image by key
+// Runs of width 1, 2, 4, ... are merged back and forth between the image and a
+// temporary buffer
+static void sort_entries(int_t snap) {
+  int_t n = snap_size(snap);
+  int_t keys = keys_addr(snap);
+  int_t vals = vals_addr(snap);
+  int_t tmp = fm_alloc(2 * n);
+  int_t tmp_keys = tmp;
+  int_t tmp_vals = tmp + n;
+  int_t width = 1;
+
+  while (width < n) {
+    int_t lo = 0;
+    while (lo < n) {
+      int_t mid = lo + width < n ? lo + width : n;
+      int_t hi = mid + width < n ? mid + width : n;
+      merge(keys, vals, tmp_keys, tmp_vals, lo, mid, hi);
+      lo = hi;
+    }
+
+    int_t swap = keys;
+    keys = tmp_keys;
+    tmp_keys = swap;
+    swap = vals;
+    vals = tmp_vals;
+    tmp_vals = swap;
+    width = 2 * width;
+  }
+
+  if (keys != keys_addr(snap)) {
+    std_fmemcpy(keys_addr(snap), keys, n);
+    std_fmemcpy(vals_addr(snap), vals, n);
+  }
+  fm_free(tmp);
+}
+
+// Returns the rank of key, or -1 if not found
+static int_t find_key(int_t snap, int_t key) {
+  int_t keys = keys_addr(snap);
+  int_t lo = 0;
+  int_t hi = snap_size(snap);
+
+  while (lo < hi) {
+    int_t mid = lo + (hi - lo) / 2;
+    int_t mid_key = std_fmemget(keys + mid);
+    if (key < mid_key)
+      hi = mid;
+    else if (key > mid_key)
+      lo = mid + 1;
+    else
+      return mid;
+  }
+
+  return -1;
+}
+
+// Byte streams: the standard input / output (stream 0), or a bytes array
+// in flat memory, one byte per word
+// Stream layout:
+// - stream[0]: bytes array
+// - stream[1]: length of the array
+// - stream[2]: position of the next byte
+
+static int_t stream_new(int_t buf, int_t len) {
+  int_t stream = fm_alloc(3);
+  std_fmemset(stream, buf);
+  std_fmemset(stream + 1, len);
+  std_fmemset(stream + 2, 0);
+  return stream;
+}
+
+static void stream_putc(int_t stream, int_t c) {
+  if (stream == 0) {
+    std_putc(c);
+    return;
+  }
+  int_t pos = std_fmemget(stream + 2);
+  panic_ifn(pos < std_fmemget(stream + 1));
+  std_fmemset(std_fmemget(stream) + pos, c);
+  std_fmemset(stream + 2, pos + 1);
+}
+
+// Returns the next byte, or -1 at the end of the stream
+static int_t stream_getc(int_t stream) {
+  if (stream == 0)
+    return std_getc();
+  int_t pos = std_fmemget(stream + 2);
+  if (pos == std_fmemget(stream + 1))
+    return -1;
+  std_fmemset(stream + 2, pos + 1);
+  return std_fmemget(std_fmemget(stream) + pos);
+}
+
+static void write_word(int_t stream, int_t x) {
+  uint32_t w = (uint32_t)x;
+  int_t i = 0;
+  while (i < 4) {
+    stream_putc(stream, (int_t)(w & 0xFFu));
+    w = w >> 8;
+    i = i + 1;
+  }
+}
+
+// Set *ok to 0 if the stream ends before the 4 bytes
+static int_t read_word(int_t stream, int_t *ok) {
+  uint32_t w = 0;
+  int_t i = 0;
+  while (i < 4) {
+    int_t c = stream_getc(stream);
+    if (c < 0 || c > 255)
+      *ok = 0;
+    w = w | ((uint32_t)(c & 0xFF) << (8 * i));
+    i = i + 1;
+  }
+  return (int_t)w;
+}
+
+static void write_image(int_t snap, int_t stream) {
+  int_t len = snap_len(snap);
+  int_t i = 0;
+  while (i < len) {
+    write_word(stream, std_fmemget(snap + i));
+    i = i + 1;
+  }
+}
+
+// Returns the number of bytes left in the stream, or -1 if unknown (standard
+// input)
+static int_t stream_left(int_t stream) {
+  if (stream == 0)
+    return -1;
+  return std_fmemget(stream + 1) - std_fmemget(stream + 2);
+}
+
+// Returns a new snapshot with the image read from the stream, or 0 if it's
+// not a valid image: wrong magic number, bad size, stream too short, or keys
+// not sorted
+// The number of entries is checked before the allocation, against the bytes
+// left in the stream when known (8 per entry)
+// Otherwise the image is allocated by chunks, doubling as the words arrive: a
+// bad size can't allocate more than twice what was actually read
+static int_t read_image(int_t stream) {
+  int_t ok = 1;
+  if (read_word(stream, &ok) != SNAP_MAGIC || ok == 0)
+    return 0;
+  int_t n = read_word(stream, &ok);
+  int_t left = stream_left(stream);
+  if (ok == 0 || n < 0 || n > STD_FMEM_SIZE / 2 || (left >= 0 && n > left / 8))
+    return 0;
+
+  int_t len = 2 + 2 * n;
+  int_t cap = left < 0 && len > READ_CHUNK ? READ_CHUNK : len;
+  int_t snap = fm_alloc(cap);
+  std_fmemset(snap, SNAP_MAGIC);
+  std_fmemset(snap + 1, n);
+
+  int_t i = 2;
+  while (i < len && ok) {
+    if (i == cap) {
+      cap = 2 * cap < len ? 2 * cap : len;
+      int_t grown = fm_alloc(cap);
+      std_fmemcpy(grown, snap, i);
+      fm_free(snap);
+      snap = grown;
+    }
+    std_fmemset(snap + i, read_word(stream, &ok));
+    i = i + 1;
+  }
+
+  // The keys must be sorted for the binary search
+  i = 1;
+  while (i < n && ok) {
+    ok = std_fmemget(keys_addr(snap) + i - 1) <
+         std_fmemget(keys_addr(snap) + i);
+    i = i + 1;
+  }
+
+  if (ok == 0) {
+    fm_free(snap);
+    return 0;
+  }
+  return snap;
+}
+
+int_t snap_new(int_t st) {
+  int_t n = table_size(st);
+  int_t snap = fm_alloc(2 + 2 * n);
+  std_fmemset(snap, SNAP_MAGIC);
+  std_fmemset(snap + 1, n);
+
+  int_t it = table_it_new(st);
+  int_t i = 0;
+  while (i < n) {
+    std_fmemset(keys_addr(snap) + i, table_it_get_key(it));
+    std_fmemset(vals_addr(snap) + i, table_it_get_val(it));
+    table_it_next(it);
+    i = i + 1;
+  }
+  table_it_free(it);
+
+  sort_entries(snap);
+  return snap;
+}
+
+void snap_free(int_t snap) { fm_free(snap); }
+
+int_t snap_len(int_t snap) { return 2 + 2 * snap_size(snap); }
+
+void snap_write(int_t snap) { write_image(snap, 0); }
+
+int_t snap_read() {
+  int_t snap = read_image(0);
+  panic_ifn(snap);
+  return snap;
+}
+
+int_t snap_write_bytes(int_t snap, int_t dst) {
+  int_t len = 4 * snap_len(snap);
+  int_t stream = stream_new(dst, len);
+  write_image(snap, stream);
+  fm_free(stream);
+  return len;
+}
+
+// The whole array must be the image: trailing bytes make it invalid
+int_t snap_read_bytes(int_t src, int_t len) {
+  int_t stream = stream_new(src, len);
+  int_t snap = read_image(stream);
+  if (snap && stream_getc(stream) != -1) {
+    snap_free(snap);
+    snap = 0;
+  }
+  fm_free(stream);
+  return snap;
+}
+
+int_t snap_get(int_t snap, int_t key) {
+  int_t k = find_key(snap, key);
+  panic_ifn(k != -1);
+  return std_fmemget(vals_addr(snap) + k);
+}
+
+int_t snap_contains(int_t snap, int_t key) {
+  return find_key(snap, key) != -1;
+}
+
+int_t snap_size(int_t snap) { return std_fmemget(snap + 1); }
+
+int_t snap_key_at(int_t snap, int_t k) {
+  panic_ifn(k >= 0 && k < snap_size(snap));
+  return std_fmemget(keys_addr(snap) + k);
+}
+
+int_t snap_val_at(int_t snap, int_t k) {
+  panic_ifn(k >= 0 && k < snap_size(snap));
+  return std_fmemget(vals_addr(snap) + k);
+}
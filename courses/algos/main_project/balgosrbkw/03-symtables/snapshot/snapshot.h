@@ -0,0 +1,64 @@
+#ifndef SNAPSHOT_H_
+#define SNAPSHOT_H_
+
+#include "lestd.h"
+
+// Symbols table snapshot
+// Compact read-only image of a symbols table: the key/value pairs sorted by
+// key, in one contiguous block.
+// The image contains no pointer, so it can be copied anywhere in memory,
+// written out and read back as-is, and queried in place without rebuilding a
+// table.
+// Works with any symbols table implementation (only uses table.h)
+// Loading is not zero-copy: snap_read / snap_read_bytes copy the image word by
+// word into a new block, O(n). Only an image already in flat memory (e.g. a
+// copy of a snapshot block) is queried in place.
+
+// Allocate memory for a new snapshot of the symbols table st
+int_t snap_new(int_t st);
+
+// Clear all the memory allocated for the snapshot
+void snap_free(int_t snap);
+
+// Returns the number of words of the image
+int_t snap_len(int_t snap);
+
+// Write the image to the standard output
+void snap_write(int_t snap);
+
+// Allocate memory for a snapshot, and fill it with an image read from the
+// standard input (up to the end of the image, not of the input)
+// Panic if the input is not a valid image
+int_t snap_read();
+
+// Write the image to the bytes array dst (one byte per word), the same bytes
+// as snap_write
+// dst must have room for 4 * snap_len(snap) bytes
+// Returns the number of bytes written
+int_t snap_write_bytes(int_t snap, int_t dst);
+
+// Allocate memory for a snapshot, and fill it with the image in the `len`
+// bytes of the array src
+// Returns 0 if they are not exactly a valid image (checked the same way as
+// snap_read)
+int_t snap_read_bytes(int_t src, int_t len);
+
+// Returns the value associated with a key
+// Panic if the key is not found
+int_t snap_get(int_t snap, int_t key);
+
+// Returns 1 if key is found, 0 otherwhise
+int_t snap_contains(int_t snap, int_t key);
+
+// Returns the number of elements in the snapshot
+int_t snap_size(int_t snap);
+
+// Returns the key with rank k (keys are sorted in increasing order)
+// Panic if k is not in [0, size[
+int_t snap_key_at(int_t snap, int_t k);
+
+// Returns the value of the key with rank k
+// Panic if k is not in [0, size[
+int_t snap_val_at(int_t snap, int_t k);
+
+#endif //! SNAPSHOT_H_
@@ -0,0 +1,116 @@
+#include <iostream>
+#include <map>
+#include <string>
+
+void print_snap(const std::map<int, int> &st) {
+  std::cout << '[';
+  std::size_t i = 0;
+  for (const auto &it : st) {
+    std::cout << '(' << it.first << ';' << it.second << ')';
+    if (++i < st.size())
+      std::cout << ", ";
+  }
+  std::cout << ']' << std::endl;
+}
+
+void printnl_int(int x) { std::cout << x << std::endl; }
+
+void test1() {
+  std::map<int, int> st;
+  printnl_int(st.size());
+  printnl_int(2);
+  printnl_int(0);
+  print_snap(st);
+}
+
+void test2() {
+  std::map<int, int> st;
+  st[3] = 78;
+  st[6] = 4;
+  st[2] = 45;
+  st[1] = 27;
+  st[2] = 37;
+  st[8] = 44;
+
+  printnl_int(st.size());
+  printnl_int(2 + 2 * st.size());
+  for (int i = 0; i < 10; ++i) {
+    printnl_int(st.count(i));
+    if (st.count(i))
+      printnl_int(st[i]);
+  }
+  print_snap(st);
+}
+
+void test3() {
+  std::map<int, int> st;
+  for (int i = 0; i < 500; ++i)
+    st[(i * 7919) % 1009 - 500] = i;
+  for (int i = -500; i < 500; i += 3)
+    st.erase(i);
+
+  printnl_int(st.size());
+  print_snap(st);
+
+  for (int i = -510; i < 510; ++i) {
+    printnl_int(st.count(i));
+    if (st.count(i))
+      printnl_int(st[i]);
+  }
+}
+
+void test4() {
+  std::map<int, int> st;
+  for (int i = 0; i < 20; ++i)
+    st[13 * i - 100] = i * i - 50;
+
+  std::cout << 4 * (2 + 2 * st.size()) << std::endl;
+  int header[] = {0x534e4150, static_cast<int>(st.size()), st.begin()->first};
+  for (int word : header)
+    for (int b = 0; b < 4; ++b)
+      std::cout << ((static_cast<unsigned>(word) >> (8 * b)) & 0xFFu) << " ";
+  std::cout << std::endl;
+
+  printnl_int(1);
+  print_snap(st);
+  printnl_int(0);
+
+  for (int i = 0; i < 5; ++i)
+    printnl_int(0);
+  printnl_int(0);
+  printnl_int(0);
+  printnl_int(st.size());
+
+  printnl_int(8);
+  printnl_int(0);
+  printnl_int(0);
+}
+
+void test5() {
+  std::string image;
+  char c;
+  while (std::cin.get(c))
+    image.push_back(c);
+
+  auto word = [&](std::size_t i) {
+    unsigned w = 0;
+    for (int b = 0; b < 4; ++b)
+      w |= static_cast<unsigned>(static_cast<unsigned char>(image[4 * i + b]))
+           << (8 * b);
+    return static_cast<int>(w);
+  };
+  std::map<int, int> st;
+  int n = word(1);
+  for (int i = 0; i < n; ++i)
+    st[word(2 + i)] = word(2 + n + i);
+  print_snap(st);
+  std::cout << image;
+}
+
+int main() {
+  test1();
+  test2();
+  test3();
+  test4();
+  test5();
+}
@@ -0,0 +1,139 @@
+#include "table.h"
+#include "binsearch.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// Implementation based on a sorted array
+// Keys and values are stored in 2 parallel arrays, keys sorted in increasing
+// order.
+// Lookups are binary searches: O(log(n))
+// Insertions and deletions shift the following entries by one slot with
+// std_fmemcpy: O(n), but it's a single contiguous copy
+// => for small tables, faster than following pointers
+//
+// The capacity is doubled when full, and halved when 1/4 full
+//
+// Memory layout:
+// - st[0]: capacity
+// - st[1]: number of entries
+// - st[2]: keys array
+// - st[3]: values array
+
+#define MIN_CAP (8)
+
+static int_t st_keys(int_t st) { return std_fmemget(st + 2); }
+
+static int_t st_vals(int_t st) { return std_fmemget(st + 3); }
+
+// Move all entries to new arrays with capacity `new_cap`
+static void table_resize(int_t st, int_t new_cap) {
+  int_t size = table_size(st);
+  int_t keys = fm_alloc(new_cap);
+  int_t vals = fm_alloc(new_cap);
+  std_fmemcpy(keys, st_keys(st), size);
+  std_fmemcpy(vals, st_vals(st), size);
+  fm_free(st_keys(st));
+  fm_free(st_vals(st));
+
+  std_fmemset(st, new_cap);
+  std_fmemset(st + 2, keys);
+  std_fmemset(st + 3, vals);
+}
+
+int_t table_new() {
+  int_t st = fm_alloc(4);
+  std_fmemset(st, MIN_CAP);
+  std_fmemset(st + 1, 0);
+  std_fmemset(st + 2, fm_alloc(MIN_CAP));
+  std_fmemset(st + 3, fm_alloc(MIN_CAP));
+  return st;
+}
+
+void table_free(int_t st) {
+  fm_free(st_keys(st));
+  fm_free(st_vals(st));
+  fm_free(st);
+}
+
+int_t table_put(int_t st, int_t key, int_t val) {
+  int_t size = table_size(st);
+  int_t idx = lower_bound(st_keys(st), size, key);
+  if (idx < size ? std_fmemget(st_keys(st) + idx) == key : 0) {
+    std_fmemset(st_vals(st) + idx, val);
+    return 0;
+  }
+
+  if (size == std_fmemget(st))
+    table_resize(st, 2 * size);
+
+  int_t keys = st_keys(st);
+  int_t vals = st_vals(st);
+  std_fmemcpy(keys + idx + 1, keys + idx, size - idx);
+  std_fmemcpy(vals + idx + 1, vals + idx, size - idx);
+  std_fmemset(keys + idx, key);
+  std_fmemset(vals + idx, val);
+  std_fmemset(st + 1, size + 1);
+  return 1;
+}
+
+int_t table_delete(int_t st, int_t key) {
+  int_t size = table_size(st);
+  int_t keys = st_keys(st);
+  int_t vals = st_vals(st);
+  int_t idx = rank(keys, size, key);
+  if (idx == -1)
+    return 0;
+
+  std_fmemcpy(keys + idx, keys + idx + 1, size - idx - 1);
+  std_fmemcpy(vals + idx, vals + idx + 1, size - idx - 1);
+  size = size - 1;
+  std_fmemset(st + 1, size);
+
+  int_t cap = std_fmemget(st);
+  if (cap > MIN_CAP && 4 * size <= cap)
+    table_resize(st, cap / 2);
+  return 1;
+}
+
+int_t table_get(int_t st, int_t key) {
+  int_t idx = rank(st_keys(st), table_size(st), key);
+  panic_ifn(idx != -1);
+  return std_fmemget(st_vals(st) + idx);
+}
+
+int_t table_contains(int_t st, int_t key) {
+  return rank(st_keys(st), table_size(st), key) != -1;
+}
+
+int_t table_size(int_t st) { return std_fmemget(st + 1); }
+
+// Iterator: index, and table
+// Walks through the arrays, in key order
+
+int_t table_it_new(int_t st) {
+  int_t it = fm_alloc(2);
+  std_fmemset(it, 0);
+  std_fmemset(it + 1, st);
+  return it;
+}
+
+void table_it_free(int_t it) { fm_free(it); }
+
+int_t table_it_is_end(int_t it) {
+  return std_fmemget(it) == table_size(std_fmemget(it + 1));
+}
+
+int_t table_it_get_key(int_t it) {
+  panic_ifn(table_it_is_end(it) == 0);
+  return std_fmemget(st_keys(std_fmemget(it + 1)) + std_fmemget(it));
+}
+
+int_t table_it_get_val(int_t it) {
+  panic_ifn(table_it_is_end(it) == 0);
+  return std_fmemget(st_vals(std_fmemget(it + 1)) + std_fmemget(it));
+}
+
+void table_it_next(int_t it) {
+  if (table_it_is_end(it) == 0)
+    std_fmemset(it, std_fmemget(it) + 1);
+}
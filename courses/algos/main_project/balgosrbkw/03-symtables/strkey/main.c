@@ -0,0 +1,152 @@
+#include "lealloc.h"
+#include "leio.h"
+#include "strkey.h"
+#include "table.h"
+
+// Write in bytes the identifier number i: len = 1 + i % 7 lowercase letters
+// Returns len
+int_t make_ident(int_t bytes, int_t i) {
+  int_t len = 1 + i % 7;
+  int_t x = i;
+  int_t k = 0;
+  while (k < len) {
+    std_fmemset(bytes + k, 97 + x % 26);
+    x = x / 26;
+    k = k + 1;
+  }
+  return len;
+}
+
+void print_str(int_t s) {
+  int_t i = 0;
+  while (i < str_len(s)) {
+    std_putc(str_byte(s, i));
+    i = i + 1;
+  }
+}
+
+int_t sign(int_t x) { return x < 0 ? -1 : (x > 0 ? 1 : 0); }
+
+// Strings, equality and order
+void test1() {
+  int_t bytes = fm_alloc(8);
+  int_t strs = fm_alloc(30);
+  int_t i = 0;
+  while (i < 30) {
+    std_fmemset(strs + i, str_new(bytes, make_ident(bytes, 11 * i % 17)));
+    i = i + 1;
+  }
+  std_fmemset(strs + 29, str_new(bytes, 0));
+
+  i = 0;
+  while (i < 30) {
+    int_t s = std_fmemget(strs + i);
+    print_str(s);
+    std_putc(32);
+    printnl_int(str_len(s));
+    int_t j = 0;
+    while (j < 30) {
+      int_t t = std_fmemget(strs + j);
+      print_int(str_eq(s, t));
+      print_int(sign(str_cmp(s, t)) + 1);
+      j = j + 1;
+    }
+    printnl();
+    i = i + 1;
+  }
+
+  i = 0;
+  while (i < 30) {
+    str_free(std_fmemget(strs + i));
+    i = i + 1;
+  }
+  fm_free(strs);
+  fm_free(bytes);
+}
+
+// Interning: one string per distinct identifier
+void test2() {
+  int_t in = intern_new();
+  int_t bytes = fm_alloc(8);
+  int_t ids = fm_alloc(300);
+
+  int_t i = 0;
+  while (i < 300) {
+    std_fmemset(ids + i, intern_get(in, bytes, make_ident(bytes, i % 170)));
+    i = i + 1;
+  }
+  printnl_int(intern_size(in));
+
+  i = 0;
+  while (i < 300) {
+    int_t len = make_ident(bytes, i % 170);
+    print_int(std_fmemget(ids + i) == intern_find(in, bytes, len));
+    print_int(std_fmemget(ids + i) == std_fmemget(ids + i % 170));
+    i = i + 1;
+  }
+  printnl();
+
+  i = 170;
+  while (i < 200) {
+    print_int(intern_find(in, bytes, make_ident(bytes, i)) != 0);
+    i = i + 1;
+  }
+  printnl();
+
+  fm_free(ids);
+  fm_free(bytes);
+  intern_free(in);
+}
+
+// Symbols table keyed by interned identifiers: occurrences count
+void test3() {
+  int_t in = intern_new();
+  int_t st = table_new();
+  int_t bytes = fm_alloc(8);
+
+  int_t i = 0;
+  while (i < 1000) {
+    int_t id = intern_get(in, bytes, make_ident(bytes, (i * 37) % 240));
+    table_put(st, id, table_contains(st, id) ? table_get(st, id) + 1 : 1);
+    i = i + 1;
+  }
+  printnl_int(table_size(st));
+
+  // Sort the identifiers with str_cmp
+  int_t n = table_size(st);
+  int_t keys = fm_alloc(n);
+  int_t it = table_it_new(st);
+  i = 0;
+  while (table_it_is_end(it) == 0) {
+    int_t j = i;
+    int_t key = table_it_get_key(it);
+    while (j > 0 && str_cmp(std_fmemget(keys + j - 1), key) > 0) {
+      std_fmemset(keys + j, std_fmemget(keys + j - 1));
+      j = j - 1;
+    }
+    std_fmemset(keys + j, key);
+    table_it_next(it);
+    i = i + 1;
+  }
+  table_it_free(it);
+
+  i = 0;
+  while (i < n) {
+    int_t key = std_fmemget(keys + i);
+    print_str(key);
+    std_putc(32);
+    printnl_int(table_get(st, key));
+    i = i + 1;
+  }
+
+  fm_free(keys);
+  fm_free(bytes);
+  table_free(st);
+  intern_free(in);
+}
+
+int main() {
+  test1();
+  test2();
+  test3();
+}
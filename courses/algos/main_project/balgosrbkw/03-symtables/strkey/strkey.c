@@ -0,0 +1,244 @@
+#include "strkey.h"
+#include "hashfn.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// The hash is computed on the packed words: FNV-1a style on words, with the
+// length as initial value, and Murmur3 finalizer
+//
+// Interner: hash set of blobs, with linear probing
+// The hash of the blobs is cached, so a probe only reads the bytes of a blob
+// with the same hash and length.
+// The capacity is a power of 2, doubled when half full.
+//
+// Interner memory layout:
+// - in[0]: capacity
+// - in[1]: number of strings
+// - in[2]: hash shift (32 - log2(capacity))
+// - in[3]: slots array (blob address, 0 if empty)
+
+#define MIN_CAP (16)
+
+static int_t nb_words(int_t len) { return (len + 3) / 4; }
+
+// Returns the word w of the byte array, packed like the blobs
+static uint32_t pack_word(int_t bytes, int_t len, int_t w) {
+  uint32_t res = 0;
+  int_t i = 4 * w;
+  while (i < 4 * w + 4) {
+    uint32_t byte = i < len ? (uint32_t)std_fmemget(bytes + i) : 0;
+    res = res * 256 + byte;
+    i = i + 1;
+  }
+  return res;
+}
+
+static uint32_t hash_step(uint32_t h, uint32_t word) {
+  return (h ^ word) * 16777619u;
+}
+
+static int_t hash_bytes(int_t bytes, int_t len) {
+  uint32_t h = (uint32_t)len;
+  int_t w = 0;
+  while (w < nb_words(len)) {
+    h = hash_step(h, pack_word(bytes, len, w));
+    w = w + 1;
+  }
+  return (int_t)hash_fmix32((int_t)h);
+}
+
+// Allocate a new string, with its hash already computed
+static int_t str_new_hash(int_t hash, int_t bytes, int_t len) {
+  int_t s = fm_alloc(2 + nb_words(len));
+  std_fmemset(s, hash);
+  std_fmemset(s + 1, len);
+
+  int_t w = 0;
+  while (w < nb_words(len)) {
+    std_fmemset(s + 2 + w, (int_t)pack_word(bytes, len, w));
+    w = w + 1;
+  }
+  return s;
+}
+
+int_t str_new(int_t bytes, int_t len) {
+  return str_new_hash(hash_bytes(bytes, len), bytes, len);
+}
+
+void str_free(int_t s) { fm_free(s); }
+
+int_t str_hash(int_t s) { return std_fmemget(s); }
+
+int_t str_len(int_t s) { return std_fmemget(s + 1); }
+
+int_t str_byte(int_t s, int_t i) {
+  panic_ifn(i >= 0 && i < str_len(s));
+  uint32_t word = (uint32_t)std_fmemget(s + 2 + i / 4);
+  return (int_t)((word >> (8 * (3 - i % 4))) % 256);
+}
+
+int_t str_eq(int_t a, int_t b) {
+  if (a == b)
+    return 1;
+  if (str_hash(a) != str_hash(b) || str_len(a) != str_len(b))
+    return 0;
+
+  int_t n = nb_words(str_len(a));
+  int_t w = 0;
+  while (w < n) {
+    if (std_fmemget(a + 2 + w) != std_fmemget(b + 2 + w))
+      return 0;
+    w = w + 1;
+  }
+  return 1;
+}
+
+// The first byte is in the high bits of a word, so comparing the words as
+// unsigned integers compares 4 bytes in lexicographic order
+// If all words of the shortest string are equal, it's a prefix of the other
+// one (the padding is 0)
+int_t str_cmp(int_t a, int_t b) {
+  if (a == b)
+    return 0;
+
+  int_t len_a = str_len(a);
+  int_t len_b = str_len(b);
+  int_t n = nb_words(len_a < len_b ? len_a : len_b);
+  int_t w = 0;
+  while (w < n) {
+    uint32_t wa = (uint32_t)std_fmemget(a + 2 + w);
+    uint32_t wb = (uint32_t)std_fmemget(b + 2 + w);
+    if (wa != wb)
+      return wa < wb ? -1 : 1;
+    w = w + 1;
+  }
+
+  return len_a < len_b ? -1 : (len_a > len_b ? 1 : 0);
+}
+
+// Returns 1 if the blob s is equal to the byte array
+static int_t str_eq_bytes(int_t s, int_t hash, int_t bytes, int_t len) {
+  if (str_hash(s) != hash || str_len(s) != len)
+    return 0;
+
+  int_t w = 0;
+  while (w < nb_words(len)) {
+    if ((uint32_t)std_fmemget(s + 2 + w) != pack_word(bytes, len, w))
+      return 0;
+    w = w + 1;
+  }
+  return 1;
+}
+
+static int_t slot_idx(int_t in, int_t hash) {
+  return (int_t)((uint32_t)hash >> std_fmemget(in + 2));
+}
+
+static int_t next_idx(int_t in, int_t idx) {
+  idx = idx + 1;
+  return idx == std_fmemget(in) ? 0 : idx;
+}
+
+// Allocate a slots array of capacity `cap`, all empty
+static void slots_init(int_t in, int_t cap) {
+  int_t shift = 32;
+  int_t n = cap;
+  while (n > 1) {
+    n = n / 2;
+    shift = shift - 1;
+  }
+
+  int_t slots = fm_alloc(cap);
+  int_t i = 0;
+  while (i < cap) {
+    std_fmemset(slots + i, 0);
+    i = i + 1;
+  }
+
+  std_fmemset(in, cap);
+  std_fmemset(in + 2, shift);
+  std_fmemset(in + 3, slots);
+}
+
+// Store the blob s, which is not in the interner, in an empty slot
+static void insert_new(int_t in, int_t s) {
+  int_t slots = std_fmemget(in + 3);
+  int_t idx = slot_idx(in, str_hash(s));
+  while (std_fmemget(slots + idx))
+    idx = next_idx(in, idx);
+  std_fmemset(slots + idx, s);
+}
+
+static void intern_grow(int_t in) {
+  int_t cap = std_fmemget(in);
+  int_t old_slots = std_fmemget(in + 3);
+  slots_init(in, 2 * cap);
+
+  int_t i = 0;
+  while (i < cap) {
+    int_t s = std_fmemget(old_slots + i);
+    if (s)
+      insert_new(in, s);
+    i = i + 1;
+  }
+  fm_free(old_slots);
+}
+
+int_t intern_new() {
+  int_t in = fm_alloc(4);
+  std_fmemset(in + 1, 0);
+  slots_init(in, MIN_CAP);
+  return in;
+}
+
+void intern_free(int_t in) {
+  int_t cap = std_fmemget(in);
+  int_t slots = std_fmemget(in + 3);
+  int_t i = 0;
+  while (i < cap) {
+    int_t s = std_fmemget(slots + i);
+    if (s)
+      str_free(s);
+    i = i + 1;
+  }
+  fm_free(slots);
+  fm_free(in);
+}
+
+// Returns the interned string equal to the byte array of hash `hash`, or 0
+static int_t find_hash(int_t in, int_t hash, int_t bytes, int_t len) {
+  int_t slots = std_fmemget(in + 3);
+  int_t idx = slot_idx(in, hash);
+  int_t s = std_fmemget(slots + idx);
+
+  while (s) {
+    if (str_eq_bytes(s, hash, bytes, len))
+      return s;
+    idx = next_idx(in, idx);
+    s = std_fmemget(slots + idx);
+  }
+  return 0;
+}
+
+int_t intern_find(int_t in, int_t bytes, int_t len) {
+  return find_hash(in, hash_bytes(bytes, len), bytes, len);
+}
+
+// The bytes are hashed once, for the lookup and the new string
+int_t intern_get(int_t in, int_t bytes, int_t len) {
+  int_t hash = hash_bytes(bytes, len);
+  int_t s = find_hash(in, hash, bytes, len);
+  if (s)
+    return s;
+
+  int_t size = intern_size(in) + 1;
+  if (2 * size > std_fmemget(in))
+    intern_grow(in);
+
+  s = str_new_hash(hash, bytes, len);
+  insert_new(in, s);
+  std_fmemset(in + 1, size);
+  return s;
+}
+
+int_t intern_size(int_t in) { return std_fmemget(in + 1); }
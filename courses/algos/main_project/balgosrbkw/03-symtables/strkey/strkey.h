@@ -0,0 +1,73 @@
+#ifndef STRKEY_H_
+#define STRKEY_H_
+
+#include "lestd.h"
+
+// Byte string keys
+// A string is stored in flat memory as a length-prefixed blob, with its hash
+// computed once at creation:
+// - s[0]: hash
+// - s[1]: length in bytes
+// - s[2..]: bytes, packed 4 per word, first byte in the high bits, last word
+//   padded with 0
+// The first word of bytes is a prefix: comparing 2 words compares 4 bytes.
+//
+// Byte arrays given to the functions have one byte (0 to 255) per word, like
+// the characters read with std_getc.
+//
+// Interning:
+// An interner stores one blob per distinct string, and returns the same blob
+// for equal strings: 2 interned strings are equal iff their addresses are
+// equal.
+// => an interned string is an int_t key usable with any symbols table, an
+// identifier lookup is interning + an integer lookup
+// The key is the address of the blob: ordered tables (bsttable, skiptable,
+// ...) keyed by interned strings iterate and range-scan in address order
+// (creation order with lealloc_v0), not in string order. For string order,
+// use a bsttable built with str_cmp as its key comparison (see strtable).
+
+// Allocate memory for a new string, copy of the `len` bytes of `bytes`
+int_t str_new(int_t bytes, int_t len);
+
+// Clear all the memory allocated for the string
+void str_free(int_t s);
+
+// Returns the cached hash of the string
+int_t str_hash(int_t s);
+
+// Returns the length of the string, in bytes
+int_t str_len(int_t s);
+
+// Returns the byte at index i of the string
+// Panic if i is not in [0, len[
+int_t str_byte(int_t s, int_t i);
+
+// Returns 1 if the strings are equal, 0 otherwhise
+// Compares the addresses, then the hashes and lengths, and only then the
+// bytes
+int_t str_eq(int_t a, int_t b);
+
+// Compare the strings in lexicographic order of bytes
+// Returns a value < 0 if a < b, 0 if a == b, > 0 if a > b
+// Compares 4 bytes at a time, starting with the prefix word
+int_t str_cmp(int_t a, int_t b);
+
+// Allocate memory for a new empty interner
+int_t intern_new();
+
+// Clear all the memory allocated for the interner, and for all its strings
+void intern_free(int_t in);
+
+// Returns the interned string equal to the `len` bytes of `bytes`, creating it
+// if needed
+int_t intern_get(int_t in, int_t bytes, int_t len);
+
+// Returns the interned string equal to the `len` bytes of `bytes`, or 0 if
+// there is none
+// Never allocates memory
+int_t intern_find(int_t in, int_t bytes, int_t len);
+
+// Returns the number of strings in the interner
+int_t intern_size(int_t in);
+
+#endif //! STRKEY_H_
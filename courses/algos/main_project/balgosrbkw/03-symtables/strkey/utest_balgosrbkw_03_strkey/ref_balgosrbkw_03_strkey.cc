@@ -0,0 +1,61 @@
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+std::string make_ident(int i) {
+  std::string res;
+  int x = i;
+  for (int k = 0; k < 1 + i % 7; ++k) {
+    res.push_back(static_cast<char>('a' + x % 26));
+    x /= 26;
+  }
+  return res;
+}
+
+int sign(int x) { return x < 0 ? -1 : (x > 0 ? 1 : 0); }
+
+void test1() {
+  std::vector<std::string> strs;
+  for (int i = 0; i < 30; ++i)
+    strs.push_back(make_ident(11 * i % 17));
+  strs[29] = "";
+
+  for (const auto &s : strs) {
+    std::cout << s << " " << s.size() << std::endl;
+    for (const auto &t : strs)
+      std::cout << (s == t) << sign(s.compare(t)) + 1;
+    std::cout << std::endl;
+  }
+}
+
+void test2() {
+  std::map<std::string, int> in;
+  for (int i = 0; i < 300; ++i)
+    in[make_ident(i % 170)] = 1;
+  std::cout << in.size() << std::endl;
+
+  for (int i = 0; i < 300; ++i)
+    std::cout << 1 << 1;
+  std::cout << std::endl;
+
+  for (int i = 170; i < 200; ++i)
+    std::cout << in.count(make_ident(i));
+  std::cout << std::endl;
+}
+
+void test3() {
+  std::map<std::string, int> st;
+  for (int i = 0; i < 1000; ++i)
+    ++st[make_ident((i * 37) % 240)];
+  std::cout << st.size() << std::endl;
+
+  for (const auto &p : st)
+    std::cout << p.first << " " << p.second << std::endl;
+}
+
+int main() {
+  test1();
+  test2();
+  test3();
+}
@@ -0,0 +1,195 @@
+#include "lealloc.h"
+#include "leio.h"
+#include "strkey.h"
+#include "table.h"
+
+// Write in bytes the identifier number i: len = 1 + i % 5 lowercase letters
+// Returns len
+int_t make_ident(int_t bytes, int_t i) {
+  int_t len = 1 + i % 5;
+  int_t x = i * 7919;
+  int_t k = 0;
+  while (k < len) {
+    std_fmemset(bytes + k, 97 + x % 26);
+    x = x / 26;
+    k = k + 1;
+  }
+  return len;
+}
+
+void print_str(int_t s) {
+  int_t i = 0;
+  while (i < str_len(s)) {
+    std_putc(str_byte(s, i));
+    i = i + 1;
+  }
+}
+
+void print_entries(int_t st) {
+  int_t it = table_it_new(st);
+  while (table_it_is_end(it) == 0) {
+    print_str(table_it_get_key(it));
+    std_putc(32);
+    printnl_int(table_it_get_val(it));
+    table_it_next(it);
+  }
+  table_it_free(it);
+}
+
+// Interned identifiers, iterated in string order
+int_t fill(int_t in, int_t bytes) {
+  int_t st = table_new();
+  int_t i = 0;
+  while (i < 300) {
+    int_t s = intern_get(in, bytes, make_ident(bytes, i));
+    table_put(st, s, i);
+    i = i + 1;
+  }
+  return st;
+}
+
+void test1() {
+  int_t bytes = fm_alloc(8);
+  int_t in = intern_new();
+  int_t st = fill(in, bytes);
+
+  printnl_int(table_size(st));
+  print_entries(st);
+  print_str(table_min(st));
+  printnl();
+  print_str(table_max(st));
+  printnl();
+
+  int_t k = 0;
+  while (k < table_size(st)) {
+    int_t s = table_select(st, k);
+    print_str(s);
+    std_putc(32);
+    printnl_int(table_rank(st, s));
+    k = k + 17;
+  }
+
+  table_free(st);
+  intern_free(in);
+  fm_free(bytes);
+}
+
+// Ordered queries with strings that are not keys, nor interned
+void test2() {
+  int_t bytes = fm_alloc(8);
+  int_t in = intern_new();
+  int_t st = fill(in, bytes);
+  int_t size = table_size(st);
+
+  int_t probes = fm_alloc(21);
+  int_t j = 0;
+  while (j < 20) {
+    std_fmemset(probes + j, str_new(bytes, make_ident(bytes, 1000 + 37 * j)));
+    j = j + 1;
+  }
+  std_fmemset(probes + 20, str_new(bytes, 0));
+
+  j = 0;
+  while (j < 21) {
+    int_t p = std_fmemget(probes + j);
+    int_t rank = table_rank(st, p);
+    int_t found = table_contains(st, p);
+    print_str(p);
+    std_putc(32);
+    print_int(found);
+    std_putc(32);
+    print_int(rank);
+    std_putc(32);
+    if (found)
+      print_int(table_get(st, p));
+    std_putc(32);
+    if (found || rank > 0)
+      print_str(table_floor(st, p));
+    std_putc(32);
+    if (rank < size)
+      print_str(table_ceiling(st, p));
+    std_putc(32);
+    print_int(table_range_count(st, p, std_fmemget(probes + (j + 1) % 21)));
+    std_putc(32);
+
+    int_t it = table_it_new_from(st, p);
+    int_t k = 0;
+    while (k < 3 && table_it_is_end(it) == 0) {
+      print_str(table_it_get_key(it));
+      std_putc(44);
+      table_it_next(it);
+      k = k + 1;
+    }
+    table_it_free(it);
+    printnl();
+    j = j + 1;
+  }
+
+  // Delete every other identifier
+  int_t nb_deleted = 0;
+  int_t i = 0;
+  while (i < 300) {
+    int_t s = intern_find(in, bytes, make_ident(bytes, i));
+    nb_deleted = nb_deleted + table_delete(st, s);
+    i = i + 2;
+  }
+  printnl_int(nb_deleted);
+  printnl_int(table_size(st));
+  print_entries(st);
+
+  j = 0;
+  while (j < 21) {
+    str_free(std_fmemget(probes + j));
+    j = j + 1;
+  }
+  fm_free(probes);
+  table_free(st);
+  intern_free(in);
+  fm_free(bytes);
+}
+
+// Build from keys sorted by str_cmp
+void test3() {
+  int_t bytes = fm_alloc(8);
+  int_t in = intern_new();
+  int_t st = fill(in, bytes);
+  int_t n = table_size(st);
+
+  int_t keys = fm_alloc(n);
+  int_t vals = fm_alloc(n);
+  int_t it = table_it_new(st);
+  int_t i = 0;
+  while (i < n) {
+    std_fmemset(keys + i, table_it_get_key(it));
+    std_fmemset(vals + i, -table_it_get_val(it));
+    table_it_next(it);
+    i = i + 1;
+  }
+  table_it_free(it);
+
+  int_t copy = table_from_sorted(keys, vals, n);
+  printnl_int(table_size(copy));
+  int_t diffs = 0;
+  i = 0;
+  while (i < 300) {
+    int_t s = intern_find(in, bytes, make_ident(bytes, i));
+    diffs = diffs + (table_get(copy, s) != -table_get(st, s));
+    i = i + 1;
+  }
+  printnl_int(diffs);
+  print_str(table_select(copy, n / 2));
+  printnl();
+
+  table_free(copy);
+  fm_free(keys);
+  fm_free(vals);
+  table_free(st);
+  intern_free(in);
+  fm_free(bytes);
+}
+
+int main() {
+  test1();
+  test2();
+  test3();
+}
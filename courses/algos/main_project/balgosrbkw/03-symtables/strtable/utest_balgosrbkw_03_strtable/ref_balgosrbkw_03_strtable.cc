@@ -0,0 +1,98 @@
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
+std::string make_ident(int i) {
+  std::string res;
+  int x = i * 7919;
+  for (int k = 0; k < 1 + i % 5; ++k) {
+    res.push_back(static_cast<char>('a' + x % 26));
+    x /= 26;
+  }
+  return res;
+}
+
+void print_entries(const std::map<std::string, int> &st) {
+  for (const auto &it : st)
+    std::cout << it.first << " " << it.second << std::endl;
+}
+
+std::map<std::string, int> fill() {
+  std::map<std::string, int> st;
+  for (int i = 0; i < 300; ++i)
+    st[make_ident(i)] = i;
+  return st;
+}
+
+int rank(const std::map<std::string, int> &st, const std::string &key) {
+  return std::distance(st.begin(), st.lower_bound(key));
+}
+
+void test1() {
+  auto st = fill();
+  std::cout << st.size() << std::endl;
+  print_entries(st);
+  std::cout << st.begin()->first << std::endl;
+  std::cout << st.rbegin()->first << std::endl;
+
+  for (int k = 0; k < static_cast<int>(st.size()); k += 17) {
+    auto key = std::next(st.begin(), k)->first;
+    std::cout << key << " " << rank(st, key) << std::endl;
+  }
+}
+
+void test2() {
+  auto st = fill();
+  int size = st.size();
+
+  std::vector<std::string> probes;
+  for (int j = 0; j < 20; ++j)
+    probes.push_back(make_ident(1000 + 37 * j));
+  probes.push_back("");
+
+  for (int j = 0; j < 21; ++j) {
+    const auto &p = probes[j];
+    int r = rank(st, p);
+    int found = st.count(p);
+    std::cout << p << " " << found << " " << r << " ";
+    if (found)
+      std::cout << st[p];
+    std::cout << " ";
+    if (found || r > 0)
+      std::cout << std::prev(st.upper_bound(p))->first;
+    std::cout << " ";
+    if (r < size)
+      std::cout << st.lower_bound(p)->first;
+    std::cout << " ";
+    const auto &hi = probes[(j + 1) % 21];
+    int count = hi < p ? 0 : rank(st, hi) - r + static_cast<int>(st.count(hi));
+    std::cout << count << " ";
+
+    auto it = st.lower_bound(p);
+    for (int k = 0; k < 3 && it != st.end(); ++k, ++it)
+      std::cout << it->first << ",";
+    std::cout << std::endl;
+  }
+
+  int nb_deleted = 0;
+  for (int i = 0; i < 300; i += 2)
+    nb_deleted += st.erase(make_ident(i));
+  std::cout << nb_deleted << std::endl;
+  std::cout << st.size() << std::endl;
+  print_entries(st);
+}
+
+void test3() {
+  auto st = fill();
+  std::cout << st.size() << std::endl;
+  std::cout << 0 << std::endl;
+  std::cout << std::next(st.begin(), st.size() / 2)->first << std::endl;
+}
+
+int main() {
+  test1();
+  test2();
+  test3();
+}
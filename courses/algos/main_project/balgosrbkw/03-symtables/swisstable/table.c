@@ -0,0 +1,420 @@
+#include "table.h"
+#include "lealloc.h"
+#include "ledebug.h"
+
+// Implementation based on hash table with open addressing, Swiss table style
+// Slots are split in groups of 16, and every slot has a control byte:
+// - empty: 0x80
+// - deleted (tombstone): 0xFE
+// - full: 0 to 127, 7 bits tag of the key hash
+//
+// The hash is split in 2:
+// - the high bits select the first group to probe
+// - the next 7 bits are the tag
+// Search looks at a whole group at once: all slots with the same tag as the
+// key are compared, and the search stops if the group has an empty slot.
+// Otherwise it continues to the next group, with quadratic probing (+1, +2,
+// +3, ...), which visits all groups because their number is a power of 2.
+//
+// Control bytes are packed 4 per word, and a group is matched 4 slots at a
+// time with SWAR (SIMD within a register) bit tricks. The keys are only read
+// for slots with the right tag.
+//
+// Delete marks the slot as empty if its group already has an empty slot (no
+// search could have gone past this group), otherwhise as deleted.
+// The table is rebuilt when full + deleted slots go above 7/8 of the
+// capacity, to a capacity at least 16/7 the number of entries.
+// Operations are amortized O(1)
+//
+// Memory layout:
+// - st[0]: capacity (number of slots)
+// - st[1]: number of entries
+// - st[2]: number of deleted slots
+// - st[3]: hash shift (32 - log2(number of groups))
+// - st[4]: slots array: ctrl[cap / 4], keys[cap], vals[cap]
+
+#define MIN_CAP (32)
+#define GROUP_SIZE (16)
+#define BATCH_SIZE (16)
+#define CTRL_EMPTY (0x80u)
+#define CTRL_DELETED (0xFEu)
+#define LSBS (0x01010101u)
+#define MSBS (0x80808080u)
+
+static int_t st_cap(int_t st) { return std_fmemget(st); }
+
+static int_t ctrl_addr(int_t st, int_t slot) {
+  return std_fmemget(st + 4) + slot / 4;
+}
+
+static int_t key_addr(int_t st, int_t slot) {
+  return std_fmemget(st + 4) + st_cap(st) / 4 + slot;
+}
+
+static int_t val_addr(int_t st, int_t slot) {
+  return std_fmemget(st + 4) + st_cap(st) / 4 + st_cap(st) + slot;
+}
+
+static uint32_t ctrl_get(int_t st, int_t slot) {
+  uint32_t word = (uint32_t)std_fmemget(ctrl_addr(st, slot));
+  return (word >> (8 * (slot % 4))) & 0xFFu;
+}
+
+static void ctrl_set(int_t st, int_t slot, uint32_t ctrl) {
+  int_t shift = 8 * (slot % 4);
+  uint32_t word = (uint32_t)std_fmemget(ctrl_addr(st, slot));
+  word = (word & ~(0xFFu << shift)) | (ctrl << shift);
+  std_fmemset(ctrl_addr(st, slot), (int_t)word);
+}
+
+// Returns a word with the high bit set for every byte equal to tag
+// Might have false positives, the keys are compared after
+static uint32_t match_tag(uint32_t word, uint32_t tag) {
+  uint32_t x = word ^ (tag * LSBS);
+  return (x - LSBS) & ~x & MSBS;
+}
+
+// Returns a word with the high bit set for every empty byte
+static uint32_t match_empty(uint32_t word) { return word & ~(word << 6) & MSBS; }
+
+// Returns a word with the high bit set for every empty or deleted byte
+static uint32_t match_free(uint32_t word) { return word & ~(word << 7) & MSBS; }
+
+// Returns the index of the first byte set in a match word (4 if none)
+static int_t match_first(uint32_t match) {
+  int_t b = 0;
+  while (b < 4 && (match & (0x80u << (8 * b))) == 0)
+    b = b + 1;
+  return b;
+}
+
+static int_t group_has_empty(int_t st, int_t group) {
+  int_t base = std_fmemget(st + 4) + group * GROUP_SIZE / 4;
+  int_t w = 0;
+  while (w < GROUP_SIZE / 4) {
+    if (match_empty((uint32_t)std_fmemget(base + w)))
+      return 1;
+    w = w + 1;
+  }
+  return 0;
+}
+
+// Performs hashing of integer to integer
+static int_t hash_fn(int_t x) { return x * 2654435761; }
+
+static int_t hash_group(int_t st, int_t key) {
+  uint32_t h = (uint32_t)hash_fn(key);
+  return (int_t)(h >> std_fmemget(st + 3));
+}
+
+static uint32_t hash_tag(int_t st, int_t key) {
+  uint32_t h = (uint32_t)hash_fn(key);
+  return (h >> (std_fmemget(st + 3) - 7)) & 0x7Fu;
+}
+
+static int_t next_group(int_t st, int_t group, int_t i) {
+  return (group + i) % (st_cap(st) / GROUP_SIZE);
+}
+
+// Returns the slot index of `key`, or -1 if not found
+// Start searching at `group`, which must be hash_group(st, key)
+static int_t find_key_at(int_t st, int_t key, int_t group) {
+  uint32_t tag = hash_tag(st, key);
+  int_t i = 1;
+
+  while (1) {
+    int_t base = std_fmemget(st + 4) + group * GROUP_SIZE / 4;
+    int_t has_empty = 0;
+    int_t w = 0;
+    while (w < GROUP_SIZE / 4) {
+      uint32_t word = (uint32_t)std_fmemget(base + w);
+      uint32_t match = match_tag(word, tag);
+      while (match) {
+        int_t slot = group * GROUP_SIZE + 4 * w + match_first(match);
+        if (std_fmemget(key_addr(st, slot)) == key)
+          return slot;
+        match = match & (match - 1);
+      }
+
+      has_empty = has_empty || match_empty(word);
+      w = w + 1;
+    }
+
+    if (has_empty)
+      return -1;
+    group = next_group(st, group, i);
+    i = i + 1;
+  }
+}
+
+static int_t find_key(int_t st, int_t key) {
+  return find_key_at(st, key, hash_group(st, key));
+}
+
+// Returns the first empty or deleted slot in the probe sequence of `key`
+static int_t find_free(int_t st, int_t key) {
+  int_t group = hash_group(st, key);
+  int_t i = 1;
+
+  while (1) {
+    int_t base = std_fmemget(st + 4) + group * GROUP_SIZE / 4;
+    int_t w = 0;
+    while (w < GROUP_SIZE / 4) {
+      uint32_t match = match_free((uint32_t)std_fmemget(base + w));
+      if (match)
+        return group * GROUP_SIZE + 4 * w + match_first(match);
+      w = w + 1;
+    }
+
+    group = next_group(st, group, i);
+    i = i + 1;
+  }
+}
+
+// Insert an entry which is not in the table
+// There must be at least one free slot
+static void insert_new(int_t st, int_t key, int_t val) {
+  int_t slot = find_free(st, key);
+  if (ctrl_get(st, slot) == CTRL_DELETED)
+    std_fmemset(st + 2, std_fmemget(st + 2) - 1);
+
+  ctrl_set(st, slot, hash_tag(st, key));
+  std_fmemset(key_addr(st, slot), key);
+  std_fmemset(val_addr(st, slot), val);
+}
+
+static void slots_init(int_t st, int_t cap) {
+  int_t shift = 32;
+  int_t n = cap / GROUP_SIZE;
+  while (n > 1) {
+    n = n / 2;
+    shift = shift - 1;
+  }
+
+  int_t arr = fm_alloc(cap / 4 + 2 * cap);
+  std_fmemset(st, cap);
+  std_fmemset(st + 2, 0);
+  std_fmemset(st + 3, shift);
+  std_fmemset(st + 4, arr);
+
+  int_t i = 0;
+  while (i < cap / 4) {
+    std_fmemset(arr + i, (int_t)(CTRL_EMPTY * LSBS));
+    i = i + 1;
+  }
+}
+
+// Move all entries to a new slots array, with enough capacity for
+// `size` entries, without deleted slots
+static void table_rebuild(int_t st, int_t size) {
+  int_t cap = st_cap(st);
+  int_t arr = std_fmemget(st + 4);
+  int_t new_cap = MIN_CAP;
+  while (7 * new_cap < 16 * size)
+    new_cap = 2 * new_cap;
+
+  slots_init(st, new_cap);
+
+  int_t slot = 0;
+  while (slot < cap) {
+    uint32_t word = (uint32_t)std_fmemget(arr + slot / 4);
+    if (((word >> (8 * (slot % 4))) & CTRL_EMPTY) == 0)
+      insert_new(st, std_fmemget(arr + cap / 4 + slot),
+                 std_fmemget(arr + cap / 4 + cap + slot));
+    slot = slot + 1;
+  }
+
+  fm_free(arr);
+}
+
+int_t table_new() {
+  int_t st = fm_alloc(5);
+  std_fmemset(st + 1, 0);
+  slots_init(st, MIN_CAP);
+  return st;
+}
+
+// Size the table once for `n` entries, so that the insertions never resize
+// it, and insert them all with the batched put
+int_t table_from_array(int_t keys, int_t vals, int_t n) {
+  int_t cap = MIN_CAP;
+  while (8 * n > 7 * cap)
+    cap = 2 * cap;
+
+  int_t st = fm_alloc(5);
+  std_fmemset(st + 1, 0);
+  slots_init(st, cap);
+  table_put_many(st, keys, vals, n);
+  return st;
+}
+
+void table_free(int_t st) {
+  fm_free(std_fmemget(st + 4));
+  fm_free(st);
+}
+
+int_t table_put(int_t st, int_t key, int_t val) {
+  int_t slot = find_key(st, key);
+  if (slot != -1) {
+    std_fmemset(val_addr(st, slot), val);
+    return 0;
+  }
+
+  int_t size = std_fmemget(st + 1);
+  int_t used = size + std_fmemget(st + 2);
+  if (8 * (used + 1) > 7 * st_cap(st))
+    table_rebuild(st, size + 1);
+
+  insert_new(st, key, val);
+  std_fmemset(st + 1, size + 1);
+  return 1;
+}
+
+int_t table_delete(int_t st, int_t key) {
+  int_t slot = find_key(st, key);
+  if (slot == -1)
+    return 0;
+
+  if (group_has_empty(st, slot / GROUP_SIZE)) {
+    ctrl_set(st, slot, CTRL_EMPTY);
+  } else {
+    ctrl_set(st, slot, CTRL_DELETED);
+    std_fmemset(st + 2, std_fmemget(st + 2) + 1);
+  }
+
+  std_fmemset(st + 1, std_fmemget(st + 1) - 1);
+  return 1;
+}
+
+int_t table_get(int_t st, int_t key) {
+  int_t slot = find_key(st, key);
+  panic_ifn(slot != -1);
+  return std_fmemget(val_addr(st, slot));
+}
+
+int_t table_contains(int_t st, int_t key) { return find_key(st, key) != -1; }
+
+int_t table_size(int_t st) { return std_fmemget(st + 1); }
+
+// Batched lookups
+// The keys are processed by chunks of BATCH_SIZE, in 2 passes:
+// 1) hash all keys, and prefetch the control bytes and keys of their group
+// 2) search all keys
+// => the cache misses of the whole chunk overlap, instead of waiting for each
+// one before computing the next address
+// Write in out[i] the slot of keys[i], or -1 if not found
+static void batch_find(int_t st, int_t keys, int_t n, int_t out) {
+  int_t beg = 0;
+  while (beg < n) {
+    int_t end = beg + BATCH_SIZE < n ? beg + BATCH_SIZE : n;
+
+    int_t i = beg;
+    while (i < end) {
+      int_t group = hash_group(st, std_fmemget(keys + i));
+      std_fmemprefetch(ctrl_addr(st, group * GROUP_SIZE));
+      std_fmemprefetch(key_addr(st, group * GROUP_SIZE));
+      std_fmemset(out + i, group);
+      i = i + 1;
+    }
+
+    i = beg;
+    while (i < end) {
+      int_t group = std_fmemget(out + i);
+      std_fmemset(out + i, find_key_at(st, std_fmemget(keys + i), group));
+      i = i + 1;
+    }
+
+    beg = end;
+  }
+}
+
+void table_get_many(int_t st, int_t keys, int_t n, int_t out) {
+  batch_find(st, keys, n, out);
+  int_t i = 0;
+  while (i < n) {
+    int_t slot = std_fmemget(out + i);
+    panic_ifn(slot != -1);
+    std_fmemset(out + i, std_fmemget(val_addr(st, slot)));
+    i = i + 1;
+  }
+}
+
+void table_contains_many(int_t st, int_t keys, int_t n, int_t out) {
+  batch_find(st, keys, n, out);
+  int_t i = 0;
+  while (i < n) {
+    std_fmemset(out + i, std_fmemget(out + i) != -1);
+    i = i + 1;
+  }
+}
+
+// Puts can rebuild the table, so only the hashing and prefetching is done
+// ahead for the whole chunk
+int_t table_put_many(int_t st, int_t keys, int_t vals, int_t n) {
+  int_t res = 0;
+  int_t beg = 0;
+  while (beg < n) {
+    int_t end = beg + BATCH_SIZE < n ? beg + BATCH_SIZE : n;
+
+    int_t i = beg;
+    while (i < end) {
+      int_t group = hash_group(st, std_fmemget(keys + i));
+      std_fmemprefetch(ctrl_addr(st, group * GROUP_SIZE));
+      std_fmemprefetch(key_addr(st, group * GROUP_SIZE));
+      i = i + 1;
+    }
+
+    i = beg;
+    while (i < end) {
+      res = res + table_put(st, std_fmemget(keys + i), std_fmemget(vals + i));
+      i = i + 1;
+    }
+
+    beg = end;
+  }
+
+  return res;
+}
+
+// Iterator: slot index, and table
+// Walks through the slots array, skipping the empty and deleted slots
+
+int_t table_it_new(int_t st) {
+  int_t it = fm_alloc(2);
+  std_fmemset(it, -1);
+  std_fmemset(it + 1, st);
+  table_it_next(it);
+  return it;
+}
+
+void table_it_free(int_t it) { fm_free(it); }
+
+int_t table_it_is_end(int_t it) {
+  int_t st = std_fmemget(it + 1);
+  return std_fmemget(it) == st_cap(st);
+}
+
+int_t table_it_get_key(int_t it) {
+  int_t st = std_fmemget(it + 1);
+  panic_ifn(table_it_is_end(it) == 0);
+  return std_fmemget(key_addr(st, std_fmemget(it)));
+}
+
+int_t table_it_get_val(int_t it) {
+  int_t st = std_fmemget(it + 1);
+  panic_ifn(table_it_is_end(it) == 0);
+  return std_fmemget(val_addr(st, std_fmemget(it)));
+}
+
+void table_it_next(int_t it) {
+  int_t slot = std_fmemget(it);
+  int_t st = std_fmemget(it + 1);
+  int_t cap = st_cap(st);
+
+  if (slot < cap) {
+    slot = slot + 1;
+    while (slot < cap ? (ctrl_get(st, slot) & CTRL_EMPTY) != 0 : 0)
+      slot = slot + 1;
+    std_fmemset(it, slot);
+  }
+}
@@ -0,0 +1,56 @@
+// Benchmark of the symbols table implementations
+// The same driver is linked against every implementation of table.h
+//
+// mixed: n random entries, then 10n random operations on keys in [0, 2n[:
+// 50% get, 30% put, 20% delete
+
+extern "C" {
+#include "table.h"
+}
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+
+namespace {
+
+using clk = std::chrono::steady_clock;
+
+void report(const char *name, int n, long ops, clk::time_point start) {
+  double secs = std::chrono::duration<double>(clk::now() - start).count();
+  std::cout << name << "\t" << n << "\t" << ops << "\t" << secs * 1e3 << "\t"
+            << ops / secs / 1e6 << std::endl;
+}
+
+void bench_mixed(int n) {
+  std::mt19937 rng(n);
+  std::uniform_int_distribution<std::int32_t> key(0, 2 * n - 1);
+  std::uniform_int_distribution<int> op(0, 9);
+  int_t st = table_new();
+  for (int i = 0; i < n; ++i)
+    table_put(st, key(rng), i);
+
+  auto start = clk::now();
+  for (int i = 0; i < 10 * n; ++i) {
+    int_t k = key(rng);
+    int r = op(rng);
+    if (r < 5)
+      table_contains(st, k) && table_get(st, k);
+    else if (r < 8)
+      table_put(st, k, i);
+    else
+      table_delete(st, k);
+  }
+  report("mixed", n, 10L * n, start);
+
+  table_free(st);
+}
+
+} // namespace
+
+int main() {
+  std::cout << "workload\tn\tops\ttime_ms\tMops/s" << std::endl;
+  for (int n = 1000; n <= 100000; n *= 10)
+    bench_mixed(n);
+}
@@ -0,0 +1,209 @@
+// YCSB-style benchmark of the symbols table implementations
+// The same driver is linked against every implementation of table.h, every
+// line of output is prefixed with the implementation name (BENCH_IMPL) so the
+// results of all the binaries can be concatenated and compared
+//
+// n entries are loaded (scrambled keys, see key_of), then NB_OPS operations:
+// - uniform: get of a uniformly random loaded key
+// - zipf: get of a loaded key, with zipfian popularity (theta = 0.99)
+// - insert: 80% put of a new key, 20% get of a loaded key
+// - delete: 80% delete, 20% put, of uniformly random loaded keys
+// - scan: 95% scan of 1 to 100 entries from a random loaded key, 5% put of a
+//   new key (only for the ordered tables, BENCH_ORDERED)
+//
+// The operations are drawn before the timed loop. The latency of 1 operation
+// out of LAT_SAMPLE is measured, for the p50 / p99 columns.
+// fm_words is the flat memory used by the load: the move of the lealloc_v0
+// top (fmem[0]). lealloc_v0 never reuses memory, so it includes the memory
+// freed by the resizes during the load.
+//
+// Sizes go from 10^2 to BENCH_MAX_N: the flat memory only has 2^24 words
+// The tables with linear operations use a smaller BENCH_MAX_N and BENCH_NB_OPS
+
+extern "C" {
+#include "table.h"
+}
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#ifndef BENCH_MAX_N
+#define BENCH_MAX_N 100000
+#endif
+
+#ifndef BENCH_NB_OPS
+#define BENCH_NB_OPS 100000
+#endif
+
+namespace {
+
+using clk = std::chrono::steady_clock;
+
+const int NB_OPS = BENCH_NB_OPS;
+const int LAT_SAMPLE = 8;
+
+enum class Op { get, contains, put, del, scan };
+
+struct Request {
+  Op op;
+  int_t key;
+  int len;
+};
+
+// Bijection on 32 bits: the loaded keys (i < n) and the new keys (i >= n)
+// are spread over all the int_t values, and never inserted in order
+int_t key_of(std::uint32_t i) {
+  return static_cast<int_t>(i * 2654435761u);
+}
+
+int_t fm_top() { return std_fmemload(0); }
+
+// Walks through len entries from key, and returns the sum of their values
+int_t run_scan(int_t st, int_t key, int len) {
+#ifdef BENCH_ORDERED
+  int_t sum = 0;
+  int_t it = table_it_new_from(st, key);
+  for (int i = 0; i < len && !table_it_is_end(it); ++i) {
+    sum += table_it_get_val(it);
+    table_it_next(it);
+  }
+  table_it_free(it);
+  return sum;
+#else
+  (void)st;
+  (void)key;
+  (void)len;
+  return 0;
+#endif
+}
+
+int_t run(int_t st, const Request &req, int_t val) {
+  switch (req.op) {
+  case Op::get:
+    return table_get(st, req.key);
+  case Op::contains:
+    return table_contains(st, req.key);
+  case Op::put:
+    return table_put(st, req.key, val);
+  case Op::del:
+    return table_delete(st, req.key);
+  case Op::scan:
+    return run_scan(st, req.key, req.len);
+  }
+  return 0;
+}
+
+void bench(const char *name, int n, const std::vector<Request> &reqs) {
+  int_t top = fm_top();
+  int_t st = table_new();
+  for (int i = 0; i < n; ++i)
+    table_put(st, key_of(i), i);
+  int_t fm_words = fm_top() - top;
+
+  std::vector<double> lats;
+  lats.reserve(reqs.size() / LAT_SAMPLE + 1);
+  volatile int_t sink = 0;
+
+  auto start = clk::now();
+  for (std::size_t i = 0; i < reqs.size(); ++i) {
+    if (i % LAT_SAMPLE) {
+      sink = run(st, reqs[i], static_cast<int_t>(i));
+    } else {
+      auto op_start = clk::now();
+      sink = run(st, reqs[i], static_cast<int_t>(i));
+      lats.push_back(
+          std::chrono::duration<double, std::nano>(clk::now() - op_start)
+              .count());
+    }
+  }
+  double secs = std::chrono::duration<double>(clk::now() - start).count();
+  (void)sink;
+
+  std::sort(lats.begin(), lats.end());
+  std::cout << BENCH_IMPL << "\t" << name << "\t" << n << "\t" << reqs.size()
+            << "\t" << secs * 1e3 << "\t" << reqs.size() / secs / 1e6 << "\t"
+            << lats[lats.size() / 2] << "\t" << lats[lats.size() * 99 / 100]
+            << "\t" << fm_words << std::endl;
+
+  table_free(st);
+}
+
+void bench_uniform(int n) {
+  std::mt19937 rng(n);
+  std::uniform_int_distribution<int> idx(0, n - 1);
+  std::vector<Request> reqs(NB_OPS);
+  for (Request &req : reqs)
+    req = {Op::get, key_of(idx(rng)), 0};
+  bench("uniform", n, reqs);
+}
+
+void bench_zipf(int n) {
+  std::mt19937 rng(n);
+  std::vector<double> weights(n);
+  for (int i = 0; i < n; ++i)
+    weights[i] = 1.0 / std::pow(i + 1, 0.99);
+  std::discrete_distribution<int> idx(weights.begin(), weights.end());
+  std::vector<Request> reqs(NB_OPS);
+  for (Request &req : reqs)
+    req = {Op::get, key_of(idx(rng)), 0};
+  bench("zipf", n, reqs);
+}
+
+void bench_insert(int n) {
+  std::mt19937 rng(n);
+  std::uniform_int_distribution<int> idx(0, n - 1);
+  std::uniform_int_distribution<int> pick(0, 9);
+  std::uint32_t next = n;
+  std::vector<Request> reqs(NB_OPS);
+  for (Request &req : reqs)
+    req = pick(rng) < 8 ? Request{Op::put, key_of(next++), 0}
+                        : Request{Op::contains, key_of(idx(rng)), 0};
+  bench("insert", n, reqs);
+}
+
+void bench_delete(int n) {
+  std::mt19937 rng(n);
+  std::uniform_int_distribution<int> idx(0, n - 1);
+  std::uniform_int_distribution<int> pick(0, 9);
+  std::vector<Request> reqs(NB_OPS);
+  for (Request &req : reqs)
+    req = {pick(rng) < 8 ? Op::del : Op::put, key_of(idx(rng)), 0};
+  bench("delete", n, reqs);
+}
+
+#ifdef BENCH_ORDERED
+void bench_scan(int n) {
+  std::mt19937 rng(n);
+  std::uniform_int_distribution<int> idx(0, n - 1);
+  std::uniform_int_distribution<int> len(1, 100);
+  std::uniform_int_distribution<int> pick(0, 19);
+  std::uint32_t next = n;
+  std::vector<Request> reqs(NB_OPS);
+  for (Request &req : reqs)
+    req = pick(rng) ? Request{Op::scan, key_of(idx(rng)), len(rng)}
+                    : Request{Op::put, key_of(next++), 0};
+  bench("scan", n, reqs);
+}
+#endif
+
+} // namespace
+
+int main() {
+  std::cout << "impl\tworkload\tn\tops\ttime_ms\tMops/s\tp50_ns\tp99_ns\t"
+               "fm_words"
+            << std::endl;
+  for (int n = 100; n <= BENCH_MAX_N; n *= 10) {
+    bench_uniform(n);
+    bench_zipf(n);
+    bench_insert(n);
+    bench_delete(n);
+#ifdef BENCH_ORDERED
+    bench_scan(n);
+#endif
+  }
+}
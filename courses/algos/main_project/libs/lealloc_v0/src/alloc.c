@@ -1,11 +1,16 @@
 #include "lealloc.h"
 
 // This implementation keeps allocating but never free
+// The top is moved with an atomic compare-and-swap, so several threads can
+// allocate at the same time
 
 int_t fm_alloc(int_t len) {
-  int_t top = std_fmemget(0);
-  top = top ? top : 1;
-  std_fmemset(0, top + len);
+  int_t old_top = std_fmemload(0);
+  int_t top = old_top ? old_top : 1;
+  while (std_fmemcas(0, old_top, top + len) == 0) {
+    old_top = std_fmemload(0);
+    top = old_top ? old_top : 1;
+  }
   return top;
 }
 
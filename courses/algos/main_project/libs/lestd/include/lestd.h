@@ -7,6 +7,11 @@ typedef int32_t int_t;
 
 #define STD_FMEM_SIZE (16 * 1024 * 1024)
 
+// Number of flat memory entries per cache line (64 bytes)
+// The flat memory starts on a cache line: the entries at indices multiple of
+// STD_FMEM_LINE_WORDS start a line
+#define STD_FMEM_LINE_WORDS (16)
+
 // Write one byte to the standard output
 void std_putc(int_t byte_val);
 
@@ -26,4 +31,44 @@ void std_fmemset(int_t pos, int_t val);
 // src and dst can overlap
 void std_fmemcpy(int_t dst, int_t src, int_t n);
 
+// Hint that the flat memory entry at index pos will soon be accessed
+// Does nothing if pos is out of range
+void std_fmemprefetch(int_t pos);
+
+// Atomic operations on the flat memory
+// They can be used to share the flat memory between several threads
+// The flat memory must be accessed at least once before starting the threads
+
+// Atomically read the flat memory entry at index pos
+// No later memory access can be moved before it (acquire)
+int_t std_fmemload(int_t pos);
+
+// Atomically write the flat memory entry at index pos
+// No earlier memory access can be moved after it (release)
+void std_fmemstore(int_t pos, int_t val);
+
+// If the flat memory entry at index pos is `expected`, replace it with
+// `desired`, as a single atomic operation
+// Returns 1 if it was replaced, 0 otherwhise
+int_t std_fmemcas(int_t pos, int_t expected, int_t desired);
+
+// Atomically add `diff` to the flat memory entry at index pos
+// Returns the value before the addition
+int_t std_fmemxadd(int_t pos, int_t diff);
+
+// Full memory barrier: no memory access can be moved across it
+void std_fmemfence();
+
+// Let the other threads run before continuing
+void std_yield();
+
+// Maximum number of threads of std_parallel
+#define STD_MAX_THREADS (64)
+
+// Run fn(ctx, i) for every i in [0, nb_threads[, each one on its own thread,
+// and wait until they all return
+// Panic if nb_threads is not in [1, STD_MAX_THREADS]
+void std_parallel(int_t nb_threads, void (*fn)(int_t ctx, int_t idx),
+                  int_t ctx);
+
 #endif //! LESTD_H_
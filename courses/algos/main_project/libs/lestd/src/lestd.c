@@ -1,13 +1,15 @@
 #include "lestd.h"
+#include <pthread.h>
 #include <stddef.h>
 
 int getchar();
 int putchar(int);
 void exit(int);
+int sched_yield(void);
 
 void *memmove(void *dst, const void *src, size_t n);
 
-void *malloc(size_t);
+void *aligned_alloc(size_t, size_t);
 
 static void std_check(int val, const char *mess) {
   if (val)
@@ -27,7 +29,8 @@ void std_exit(int_t ret_code) { exit(ret_code); }
 static int_t *fmem_ptr() {
   static int *res = 0;
   if (!res)
-    res = malloc(STD_FMEM_SIZE * sizeof(int_t));
+    res = aligned_alloc(STD_FMEM_LINE_WORDS * sizeof(int_t),
+                        STD_FMEM_SIZE * sizeof(int_t));
   return res;
 }
 
@@ -59,3 +62,82 @@ void std_fmemcpy(int_t dst, int_t src, int_t n) {
 
   memmove(fmem_ptr() + dst, fmem_ptr() + src, n * sizeof(int_t));
 }
+
+// Hint that the flat memory entry at index pos will soon be accessed
+// Does nothing if pos is out of range
+void std_fmemprefetch(int_t pos) {
+  if (pos >= 0 && pos < STD_FMEM_SIZE)
+    __builtin_prefetch(fmem_ptr() + pos);
+}
+
+static void std_check_pos(int_t pos) {
+  std_check(pos >= 0, "std_fmem atomic: trying to access negative index");
+  std_check(pos < STD_FMEM_SIZE,
+            "std_fmem atomic: trying to access beyond fmem size");
+}
+
+int_t std_fmemload(int_t pos) {
+  std_check_pos(pos);
+  return __atomic_load_n(fmem_ptr() + pos, __ATOMIC_ACQUIRE);
+}
+
+void std_fmemstore(int_t pos, int_t val) {
+  std_check_pos(pos);
+  __atomic_store_n(fmem_ptr() + pos, val, __ATOMIC_RELEASE);
+}
+
+int_t std_fmemcas(int_t pos, int_t expected, int_t desired) {
+  std_check_pos(pos);
+  return __atomic_compare_exchange_n(fmem_ptr() + pos, &expected, desired, 0,
+                                     __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+int_t std_fmemxadd(int_t pos, int_t diff) {
+  std_check_pos(pos);
+  return __atomic_fetch_add(fmem_ptr() + pos, diff, __ATOMIC_SEQ_CST);
+}
+
+void std_fmemfence() { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+
+void std_yield() { sched_yield(); }
+
+struct std_thread_arg {
+  void (*fn)(int_t ctx, int_t idx);
+  int_t ctx;
+  int_t idx;
+};
+
+static void *std_thread_main(void *arg) {
+  struct std_thread_arg *a = (struct std_thread_arg *)arg;
+  a->fn(a->ctx, a->idx);
+  return NULL;
+}
+
+// Thread 0 runs on the calling thread
+void std_parallel(int_t nb_threads, void (*fn)(int_t ctx, int_t idx),
+                  int_t ctx) {
+  std_check(nb_threads >= 1, "std_parallel: no thread");
+  std_check(nb_threads <= STD_MAX_THREADS, "std_parallel: too many threads");
+  fmem_ptr();
+
+  pthread_t threads[STD_MAX_THREADS];
+  struct std_thread_arg args[STD_MAX_THREADS];
+  int_t i = 1;
+  while (i < nb_threads) {
+    args[i].fn = fn;
+    args[i].ctx = ctx;
+    args[i].idx = i;
+    std_check(pthread_create(&threads[i], NULL, std_thread_main, &args[i]) ==
+                  0,
+              "std_parallel: can't create thread");
+    i = i + 1;
+  }
+
+  fn(ctx, 0);
+
+  i = 1;
+  while (i < nb_threads) {
+    pthread_join(threads[i], NULL);
+    i = i + 1;
+  }
+}